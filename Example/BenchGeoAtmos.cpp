@@ -0,0 +1,287 @@
+/**
+ * @file BenchGeoAtmos.cpp
+ * @author fugu133
+ * @brief 大気密度計算の各段階の処理時間を計測する
+ * @version 0.1
+ * @date 2024-01-08
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <GeoAtmos/Core.hpp>
+
+using namespace geoatmos;
+
+constexpr double min_seconds = 0.2; // 1項目あたりの最短計測時間 [s]
+
+const auto dt = DateTime{"2023-12-31T00:00:00"};
+
+volatile double sink; // 計算結果が最適化で消されないようにする
+
+/**
+ * @brief f を min_seconds 以上繰り返し呼び出して1回あたりの時間を表示する
+ *
+ * @param name 項目名
+ * @param items_per_call 1回の呼び出しで処理する点数
+ * @param f 計測対象 (戻り値は sink に足し込む)
+ */
+template <class F>
+void bench(const char *name, std::size_t items_per_call, F &&f) {
+	using clock = std::chrono::steady_clock;
+
+	double acc = f(); // ウォームアップ
+	std::size_t calls = 0;
+	double elapsed = 0;
+	for (std::size_t n = 1; elapsed < min_seconds; n *= 2) {
+		const auto start = clock::now();
+		for (std::size_t i = 0; i < n; i++) acc += f();
+		elapsed += std::chrono::duration<double>(clock::now() - start).count();
+		calls += n;
+	}
+	sink = sink + acc;
+
+	const double ns_per_call = elapsed * 1e9 / calls;
+	const double items_per_sec = calls * items_per_call / elapsed;
+	std::printf("%-42s %14.1f ns/call %14.0f points/s\n", name, ns_per_call, items_per_sec);
+}
+
+/**
+ * @brief NRLMSISE-00 本体を直接呼び出すための派生クラス
+ *
+ */
+struct NrlmsiseKernel : internal::Nrlmsise {
+	using internal::Nrlmsise::gtd7;
+	using internal::Nrlmsise::tselec;
+};
+
+void benchGtd7() {
+	NrlmsiseKernel kernel;
+	internal::NrlmsiseConfig flags{};
+	for (int i = 0; i < 24; i++) flags.switches[i] = 1;
+	flags.switches[0] = 0;
+	NrlmsiseKernel::tselec(flags);
+
+	internal::NrlmsiseInput input{};
+	input.year = 2023;
+	input.doy = 172;
+	input.sec = 29000;
+	input.g_lat = 60;
+	input.g_long = -70;
+	input.lst = 16;
+	input.f107A = 150;
+	input.f107 = 150;
+	input.ap = 4;
+
+	const std::pair<const char *, double> altitudes[] = {{"gtd7 LEO (400 km)", 400}, {"gtd7 mid (100 km)", 100}, {"gtd7 low (30 km)", 30}};
+	for (const auto &[name, alt] : altitudes) {
+		input.alt = alt;
+		bench(name, 1, [&] {
+			internal::NrlmsiseOutput output{};
+			internal::NrlmsiseWorkspace ws{};
+			kernel.gtd7(input, flags, output, ws);
+			return output.d[5];
+		});
+	}
+}
+
+void benchDensity(SpaceWeather &sw) {
+	GeoAtmosDensity atmos;
+	GeoAtmosDensityT<ModelConfig{}> static_atmos;
+	const Wgs84 position{dt, Degree{135}, Degree{35}, 400e3};
+	const MagneticIndex ap;
+
+	bench("GeoAtmosDensity (manual indices)", 1, [&] { return atmos(position, 150, 150, ap).density.atmosphere; });
+	bench("GeoAtmosDensityT (manual indices)", 1, [&] { return static_atmos(position, 150, 150, ap).density.atmosphere; });
+	bench("GeoAtmosDensity::gradient (manual indices)", 1, [&] { return atmos.gradient(position, 150, 150, ap).altitude; });
+
+	if (sw.find(dt)) {
+		bench("GeoAtmosDensity (SpaceWeather)", 1, [&] { return atmos(position, sw).density.atmosphere; });
+
+		std::vector<Wgs84> track;
+		for (int i = 0; i < 1000; i++) track.emplace_back(dt + Seconds(10 * i), Degree{(i * 0.6) - 180}, Degree{(i % 180) - 89.5}, 400e3);
+		std::vector<AtmosphericParameters> out(track.size());
+		bench("GeoAtmosDensity::batch (1000 pts)", track.size(), [&] {
+			atmos.batch(std::span<const Wgs84>{track}, sw, std::span{out});
+			return out.back().density.atmosphere;
+		});
+		bench("GeoAtmosDensityT::batch (1000 pts)", track.size(), [&] {
+			static_atmos.batch(std::span<const Wgs84>{track}, sw, std::span{out});
+			return out.back().density.atmosphere;
+		});
+
+		std::vector<Wgs84Sample> samples;
+		for (const auto &pos : track) samples.push_back(pos.sample());
+		bench("GeoAtmosDensity::batch (1000 samples)", samples.size(), [&] {
+			atmos.batch(std::span<const Wgs84Sample>{samples}, sw, std::span{out});
+			return out.back().density.atmosphere;
+		});
+
+		// 同じ軌道の ECI 状態
+		const DragModel drag;
+		std::vector<DateTime> epochs;
+		Eigen::Matrix3Xd r(3, track.size()), v(3, track.size()), a;
+		for (std::size_t i = 0; i < track.size(); i++) {
+			epochs.push_back(track[i].epoch());
+			r.col(i) = track[i].toEci()();
+			v.col(i) = 7.67e3 * Eigen::Vector3d{-r(1, i), r(0, i), 0}.normalized();
+		}
+		std::vector<DragPartials> partials(track.size());
+		const Eci state(epochs[0], r.col(0));
+		bench("DragModel::acceleration", 1, [&] { return drag.acceleration(state, v.col(0), 0.02, sw).x(); });
+		bench("DragModel::acceleration (1000 pts)", track.size(), [&] {
+			drag.acceleration(epochs, r, v, 0.02, sw, a);
+			return a(0, 0);
+		});
+		bench("DragModel::acceleration+partials (1000)", track.size(), [&] {
+			drag.acceleration(epochs, r, v, 0.02, sw, a, partials);
+			return partials.back().position(0, 0);
+		});
+
+		GeoAtmosDensityT<RuntimeModelConfig{}, float> float_atmos;
+		std::vector<AtmosphericParameters> float_out(track.size());
+		bench("GeoAtmosDensityT<float>::batch (1000 pts)", track.size(), [&] {
+			float_atmos.batch(std::span<const Wgs84>{track}, sw, std::span{float_out});
+			return float_out.back().density.atmosphere;
+		});
+
+		// 単精度の球面調和展開による倍精度の結果からのずれ
+		atmos.batch(std::span<const Wgs84>{track}, sw, std::span{out});
+		double deviation = 0;
+		for (std::size_t i = 0; i < out.size(); i++) {
+			deviation = std::max(deviation, std::abs(float_out[i].density.atmosphere / out[i].density.atmosphere - 1.0));
+		}
+		std::printf("%-42s %14.3g\n", "float batch max relative deviation", deviation);
+	}
+}
+
+void benchSpaceWeather(const std::string &csv) {
+	const std::string bin = "SW-Last5Years.bin";
+	SpaceWeather(csv).writeBinary(bin);
+
+	bench("SpaceWeather load (CSV)", 1, [&] { return (double)SpaceWeather(csv).find(dt); });
+	bench("SpaceWeather load (binary)", 1, [&] { return (double)SpaceWeather(bin).find(dt); });
+
+	SpaceWeather sw(bin);
+	if (!sw.find(dt)) return;
+
+	std::int64_t h = 0;
+	bench("SpaceWeather::apIndex", 1, [&] { return (double)sw.apIndex(dt - Hours((h++ % 1000) * 3)); });
+	bench("SpaceWeather::adjustedF107", 1, [&] { return sw.adjustedF107(dt - Hours((h++ % 1000) * 3)); });
+	bench("SpaceWeather::slot", 1, [&] { return sw.slot(dt - Hours((h++ % 1000) * 3))->ap[0]; });
+}
+
+void benchDateTime() {
+	bench("DateTime(string)", 1, [] { return (double)DateTime{"2023-12-31T12:34:56.789"}.ticks(); });
+	bench("DateTime::parse", 1, [] { return (double)DateTime::parse("2023-12-31T12:34:56.789")->ticks(); });
+
+	std::vector<std::string> texts;
+	for (int i = 0; i < 1000; i++) texts.push_back((dt + Seconds(i * 3607.25)).toString());
+	const std::vector<std::string_view> views(texts.begin(), texts.end());
+	std::vector<std::int64_t> parsed(views.size());
+	bench("DateTime::parse (1000 pts)", views.size(), [&] { return (double)DateTime::parse(views, parsed) + parsed.back(); });
+
+	std::int64_t h = 0;
+	bench("DateTime::year", 1, [&] { return (double)(dt + Hours(h++ % 100000)).year(); });
+	bench("DateTime::dayOfYear", 1, [&] { return (double)(dt + Hours(h++ % 100000)).dayOfYear(); });
+	bench("DateTime::civil", 1, [&] {
+		const CivilDate date = (dt + Hours(h++ % 100000)).civil();
+		return (double)(date.year + date.day_of_year);
+	});
+
+	std::vector<std::int64_t> ticks;
+	for (int i = 0; i < 1000; i++) ticks.push_back((dt + Hours(i * 7)).ticks());
+	std::vector<CivilDate> dates(ticks.size());
+	bench("DateTime::civil (1000 pts)", ticks.size(), [&] {
+		DateTime::civil(ticks, dates);
+		return (double)dates.back().day_of_year;
+	});
+	bench("DateTime::deltaT", 1, [&] { return (dt + Hours(h++ % 100000)).deltaT().totalSeconds(); });
+
+	std::vector<std::int64_t> delta_t(ticks.size());
+	bench("DateTime::deltaT (1000 pts)", ticks.size(), [&] {
+		DateTime::deltaT(ticks, delta_t);
+		return (double)delta_t.back();
+	});
+}
+
+void benchCoordinate() {
+	std::vector<Ecef> track;
+	std::vector<double> x, y, z;
+	for (int i = 0; i < 1000; i++) {
+		track.push_back(Wgs84{dt, Degree{(i * 0.6) - 180}, Degree{(i % 180) - 89.5}, 400e3 + i * 100.0}.toEcef());
+		x.push_back(track.back().x());
+		y.push_back(track.back().y());
+		z.push_back(track.back().z());
+	}
+
+	std::size_t i = 0;
+	bench("Ecef::toWgs84", 1, [&] { return track[i++ % track.size()].toWgs84().altitude(); });
+	std::vector<double> lon(x.size()), lat(x.size()), alt(x.size());
+	bench("Ecef::toWgs84 (1000 pts)", x.size(), [&] {
+		Ecef::toWgs84(x, y, z, lon, lat, alt);
+		return alt.back();
+	});
+
+	// 10 点ずつ同じ時刻の ECI 軌道
+	std::vector<Eci> eci_track;
+	std::vector<DateTime> epochs;
+	Eigen::Matrix3Xd eci(3, track.size());
+	for (int i = 0; i < static_cast<int>(track.size()); i++) {
+		epochs.push_back(dt + Seconds((i / 10) * 10));
+		eci.col(i) = 6778e3 * Eigen::Vector3d{std::cos(i * 0.01), std::sin(i * 0.01) * 0.7, std::sin(i * 0.01) * 0.71};
+		eci_track.emplace_back(epochs.back(), eci.col(i));
+	}
+	Eigen::Matrix3Xd ecef;
+	bench("Eci::toEcef (1000 pts)", epochs.size(), [&] {
+		Eci::toEcef(epochs, eci, ecef);
+		return ecef(0, 0);
+	});
+	const FrameRotation rotation(dt);
+	bench("FrameRotation::toEcef (1000 pts)", eci.cols(), [&] {
+		rotation.toEcef(eci, ecef);
+		return ecef(0, 0);
+	});
+	const EclipticFrame ecliptic_frame(dt);
+	bench("EclipticFrame::toEci (1000 pts)", eci.cols(), [&] {
+		ecliptic_frame.toEci(eci, ecef);
+		return ecef(0, 0);
+	});
+	bench("EclipticCartesian::toEci", 1, [&] { return EclipticCartesian(dt + Seconds(i++ % 100000), eci.col(0)).toEci().y(); });
+	bench("Eci::toWgs84", 1, [&] { return eci_track[i++ % eci_track.size()].toWgs84().altitude(); });
+	bench("Eci::toWgs84 (1000 pts)", epochs.size(), [&] {
+		Eci::toWgs84(epochs, eci, lon, lat, alt);
+		return alt.back();
+	});
+
+	std::vector<EciSample> eci_samples;
+	for (const auto &pos : eci_track) eci_samples.push_back(pos.sample());
+	std::vector<Wgs84Sample> wgs84_samples(eci_samples.size());
+	bench("Eci::toWgs84 (1000 samples)", eci_samples.size(), [&] {
+		Eci::toWgs84(eci_samples, wgs84_samples);
+		return wgs84_samples.back().altitude;
+	});
+}
+
+int main(int argc, char **argv) {
+	const std::string csv = (argc > 1) ? argv[1] : "SW-Last5Years.csv";
+	SpaceWeather sw(csv);
+
+	benchGtd7();
+	benchDensity(sw);
+	if (sw.find(dt)) {
+		benchSpaceWeather(csv);
+	} else {
+		std::printf("%s not found; skipping SpaceWeather benchmarks\n", csv.c_str());
+	}
+	benchDateTime();
+	benchCoordinate();
+}
@@ -0,0 +1,87 @@
+/**
+ * @file CheckAllocationFree.cpp
+ * @author fugu133
+ * @brief 大気密度計算中にヒープ確保が行われないことの確認
+ * @version 0.1
+ * @date 2024-01-08
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+
+#include <GeoAtmos/Core.hpp>
+
+using namespace geoatmos;
+
+static std::atomic<std::size_t> allocation_count{0};
+
+void *operator new(std::size_t size) {
+	allocation_count++;
+	if (void *p = std::malloc(size ? size : 1)) return p;
+	throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+/**
+ * @brief f の実行中の operator new の呼び出し回数を確認する
+ *
+ * @return true 呼び出しがなかった
+ */
+template <class F>
+bool check(const char *name, F &&f) {
+	const std::size_t before = allocation_count;
+	f();
+	const std::size_t count = allocation_count - before;
+	std::cout << (count == 0 ? "OK   " : "FAIL ") << name << ": " << count << " allocations" << std::endl;
+	return count == 0;
+}
+
+int main() {
+	auto sw_dataset = SpaceWeather{"SW-Last5Years.csv"};
+	auto atmos = GeoAtmosDensity{};
+	const auto dt = DateTime{"2023-12-31T00:00:00"};
+
+	std::vector<Wgs84> track;
+	std::vector<double> altitudes;
+	for (int i = 0; i < 100; i++) {
+		track.emplace_back(dt + Minutes(i), Degree{i * 3.6 - 180}, Degree{i * 1.7 - 85}, (i * 10.0) * 1e3);
+		altitudes.push_back((i * 10.0) * 1e3);
+	}
+	std::vector<AtmosphericParameters> out(track.size());
+	volatile double sink = 0;
+
+	bool ok = true;
+	ok &= check("operator() (manual indices)", [&] {
+		for (const auto &pos : track) sink = sink + atmos(pos, 150, 150, MagneticIndex{}).density.atmosphere;
+	});
+	ok &= check("batch (manual indices)", [&] { atmos.batch(std::span<const Wgs84>{track}, 150, 150, MagneticIndex{}, std::span{out}); });
+	ok &= check("profile (manual indices)", [&] {
+		atmos.profile(dt, Degree{135}, Degree{35}, std::span<const double>{altitudes}, 150, 150, MagneticIndex{}, std::span{out});
+	});
+
+	if (sw_dataset.find(dt)) {
+		ok &= check("operator() (SpaceWeather)", [&] {
+			for (const auto &pos : track) sink = sink + atmos(pos, sw_dataset).density.atmosphere;
+		});
+		ok &= check("batch (SpaceWeather)", [&] { atmos.batch(std::span<const Wgs84>{track}, sw_dataset, std::span{out}); });
+		ok &= check("profile (SpaceWeather)", [&] {
+			atmos.profile(dt, Degree{135}, Degree{35}, std::span<const double>{altitudes}, sw_dataset, std::span{out});
+		});
+	} else {
+		std::cout << "SW-Last5Years.csv not found; skipping SpaceWeather checks" << std::endl;
+	}
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -25,10 +25,13 @@ int main() {
 	auto sw_dataset = SpaceWeather{"SW-Last5Years.csv"};
 	auto atmos = GeoAtmosDensity{DensityUnit::GramPerCm3, TemperatureUnit::Celsius};
 
+	auto altitudes = std::vector<double>{};
+	for (auto alt = altitude_start_km; alt <= altitude_end_km; alt += 1.0) altitudes.push_back(alt * 1e3);
+	auto params = atmos.profile(dt, longitude, latitude, altitudes, sw_dataset);
+
 	ofs << "Altitude [km], Density [g/cm^3], Temperature [deg C]" << std::endl;
-	for (auto alt = altitude_start_km; alt <= altitude_end_km; alt += 1.0) {
-		auto p = atmos(Wgs84{dt, longitude, latitude, alt * 1e3}, sw_dataset);
-		ofs << alt << ", " << p.density.atmosphere << ", " << p.temperature.at_altitude << std::endl;
+	for (std::size_t i = 0; i < altitudes.size(); i++) {
+		ofs << altitudes[i] * 1e-3 << ", " << params[i].density.atmosphere << ", " << params[i].temperature.at_altitude << std::endl;
 	}
 	ofs.close();
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+/**
+ * @file CheckCalcAtmosDensGrid.cpp
+ * @author fugu133
+ * @brief 宇宙天気情報から格子点上の大気密度を並列計算する
+ * @version 0.1
+ * @date 2024-01-06
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+
+#include <GeoAtmos/Core.hpp>
+
+using namespace geoatmos;
+
+constexpr auto hours_per_day = 24;
+constexpr auto grid_step_deg = 5.0;
+constexpr auto altitude_start_km = 100.0;
+constexpr auto altitude_end_km = 600.0;
+constexpr auto altitude_step_km = 10.0;
+
+const auto dt = DateTime{"2023-12-31T00:00:00"};
+
+int main() {
+	auto sw_dataset = SpaceWeather{"SW-Last5Years.csv"};
+	auto atmos = GeoAtmosDensity{DensityUnit::GramPerCm3, TemperatureUnit::Celsius};
+	auto evaluator = DensityGridEvaluator{atmos};
+
+	DensityGrid grid;
+	for (int h = 0; h < hours_per_day; h++) grid.epochs.push_back(dt + Hours(h));
+	for (auto lat = -90.0; lat <= 90.0; lat += grid_step_deg) grid.latitudes.push_back(Degree{lat});
+	for (auto lon = -180.0; lon < 180.0; lon += grid_step_deg) grid.longitudes.push_back(Degree{lon});
+	for (auto alt = altitude_start_km; alt <= altitude_end_km; alt += altitude_step_km) grid.altitudes.push_back(alt * 1e3);
+
+	auto start = std::chrono::steady_clock::now();
+	auto params = evaluator.evaluate(grid, sw_dataset);
+	auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << grid.size() << " points, " << evaluator.numThreads() << " threads, " << elapsed << " s" << std::endl;
+
+	auto ofs = std::ofstream{"atmos_grid.csv"};
+	ofs << "Epoch, Latitude [deg], Longitude [deg], Altitude [km], Density [g/cm^3], Temperature [deg C]" << std::endl;
+	for (std::size_t t = 0; t < grid.epochs.size(); t++) {
+		for (std::size_t la = 0; la < grid.latitudes.size(); la++) {
+			for (std::size_t lo = 0; lo < grid.longitudes.size(); lo++) {
+				for (std::size_t a = 0; a < grid.altitudes.size(); a++) {
+					const auto &p = params[grid.index(t, la, lo, a)];
+					ofs << grid.epochs[t] << ", " << grid.latitudes[la].degrees() << ", " << grid.longitudes[lo].degrees() << ", "
+						<< grid.altitudes[a] * 1e-3 << ", " << p.density.atmosphere << ", " << p.temperature.at_altitude << "\n";
+				}
+			}
+		}
+	}
+	ofs.close();
+}
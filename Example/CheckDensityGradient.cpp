@@ -0,0 +1,111 @@
+/**
+ * @file CheckDensityGradient.cpp
+ * @author fugu133
+ * @brief GeoAtmosDensity::gradient の偏微分と中心差分の比較
+ * @version 0.1
+ * @date 2024-01-12
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <GeoAtmos/Core.hpp>
+
+using namespace geoatmos;
+
+constexpr double earth_radius = 6371e3; // 偏微分を長さあたりに換算する半径 [m]
+constexpr double gradient_bound = 1e-6; // 中心差分による勾配との相対誤差の上限
+
+/**
+ * @brief 温度プロファイルの接続高度 (zn3[0] = 32.5 km など) で各評価経路の密度が有限であることを確認する
+ *
+ */
+bool checkNodes(const GeoAtmosDensity &atmos, const DateTime &dt, double f107_avg, double f107_daily, const MagneticIndex &ap) {
+	const double nodes[] = {32.5e3, 72.5e3, 120e3};
+	std::vector<Wgs84> positions;
+	for (double alt : nodes) positions.emplace_back(dt, Degree{139}, Degree{35}, alt);
+
+	std::vector<AtmosphericParameters> out(positions.size());
+	std::vector<std::uint32_t> status(positions.size());
+	atmos.batch(std::span<const Wgs84>{positions}, f107_avg, f107_daily, ap, std::span{out}, std::span{status});
+
+	bool ok = true;
+	for (std::size_t i = 0; i < positions.size(); i++) {
+		std::uint32_t point_status = EvaluationStatus::Ok;
+		const double rho = atmos(positions[i], f107_avg, f107_daily, ap).density.atmosphere;
+		const double rho_nothrow = atmos(positions[i], f107_avg, f107_daily, ap, point_status).density.atmosphere;
+		const bool node_ok = std::isfinite(rho) && rho > 0 && rho_nothrow == rho && point_status == EvaluationStatus::Ok &&
+							 out[i].density.atmosphere == rho && status[i] == EvaluationStatus::Ok;
+		std::cout << (node_ok ? "OK   " : "FAIL ") << "density at node " << nodes[i] * 1e-3 << " km: " << rho << std::endl;
+		ok &= node_ok;
+	}
+	return ok;
+}
+
+/**
+ * @brief profile が接続高度を含む各高度で operator() と一致することを確認する
+ *
+ */
+bool checkProfile(const GeoAtmosDensity &atmos, const DateTime &dt, double f107_avg, double f107_daily, const MagneticIndex &ap) {
+	const std::vector<double> altitudes = {0.0, 20e3, 32.5e3, 32.5e3, 50e3, 72.5e3, 100e3, 32.5e3, 120e3, 400e3};
+	std::vector<AtmosphericParameters> out(altitudes.size());
+	atmos.profile(dt, Degree{139}, Degree{35}, std::span<const double>{altitudes}, f107_avg, f107_daily, ap, std::span{out});
+
+	std::size_t mismatch = 0;
+	for (std::size_t i = 0; i < altitudes.size(); i++) {
+		const auto p = atmos(Wgs84{dt, Degree{139}, Degree{35}, altitudes[i]}, f107_avg, f107_daily, ap);
+		if (!(out[i].density.atmosphere == p.density.atmosphere && out[i].temperature.at_altitude == p.temperature.at_altitude)) {
+			mismatch++;
+		}
+	}
+	std::cout << (mismatch == 0 ? "OK   " : "FAIL ") << "profile matches operator(): " << mismatch << " mismatches" << std::endl;
+	return mismatch == 0;
+}
+
+int main() {
+	const GeoAtmosDensity atmos(DensityUnit::KgPerM3, TemperatureUnit::Kelvin);
+	const auto dt = DateTime{"2023-12-31T05:00:00"};
+	const double f107_avg = 150, f107_daily = 140;
+	const auto ap = MagneticIndex{15, 15, 15, 15, 15, 15, 15};
+
+	const bool nodes_ok = checkNodes(atmos, dt, f107_avg, f107_daily, ap) && checkProfile(atmos, dt, f107_avg, f107_daily, ap);
+
+	// 差分はモデルの折れ点・段差 (densu / densm の接続高度 62.5, 72.5 km や混合拡散の切り替え高度 160 ~ 450 km) を跨がない刻みと高度で取る
+	constexpr double dh = 0.5, da = 1e-7;
+	bool density_ok = true;
+	double worst = 0;
+	for (double alt : {5e3, 20e3, 50e3, 90e3, 110e3, 120e3, 150e3, 180e3, 280e3, 400e3, 600e3, 800e3}) {
+		for (double lat : {-60.0, 0.0, 35.0, 70.0}) {
+			for (double lon : {0.0, 139.0, 250.0}) {
+				const double phi = Degree(lat).radians(), lambda = Degree(lon).radians();
+				const auto rho = [&](double d_lambda, double d_phi, double d_h) {
+					return atmos(Wgs84{dt, Radian(lambda + d_lambda), Radian(phi + d_phi), alt + d_h}, f107_avg, f107_daily, ap)
+					  .density.atmosphere;
+				};
+
+				const Wgs84 pos{dt, Radian(lambda), Radian(phi), alt};
+				const DensityGradient g = atmos.gradient(pos, f107_avg, f107_daily, ap);
+				density_ok &= g.density == rho(0, 0, 0);
+
+				// 高度・緯度・経度の偏微分を長さあたりの勾配に揃えて比較する
+				const double length_lat = earth_radius, length_lon = earth_radius * std::cos(phi);
+				const Eigen::Vector3d ad{g.altitude, g.latitude / length_lat, g.longitude / length_lon};
+				const Eigen::Vector3d fd{(rho(0, 0, dh) - rho(0, 0, -dh)) / (2 * dh),
+										 (rho(0, da, 0) - rho(0, -da, 0)) / (2 * da * length_lat),
+										 (rho(da, 0, 0) - rho(-da, 0, 0)) / (2 * da * length_lon)};
+				worst = std::max(worst, (ad - fd).norm() / fd.norm());
+			}
+		}
+	}
+
+	std::cout << (density_ok ? "OK   " : "FAIL ") << "density matches operator()" << std::endl;
+	std::cout << (worst <= gradient_bound ? "OK   " : "FAIL ") << "gradient relative error: " << worst << " (bound " << gradient_bound
+			  << ")" << std::endl;
+	return nodes_ok && density_ok && worst <= gradient_bound ? EXIT_SUCCESS : EXIT_FAILURE;
+}
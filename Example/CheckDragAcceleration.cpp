@@ -0,0 +1,95 @@
+/**
+ * @file CheckDragAcceleration.cpp
+ * @author fugu133
+ * @brief DragModel の抗力加速度と偏微分の確認
+ * @version 0.1
+ * @date 2024-01-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <GeoAtmos/Core.hpp>
+
+using namespace geoatmos;
+
+constexpr double ballistic_coefficient = 0.02;  // Cd A / m [m^2/kg]
+constexpr double acceleration_bound = 1e-12;    // 大気密度から直接求めた加速度との相対誤差の上限
+constexpr double velocity_partial_bound = 1e-6; // 中心差分による ∂a/∂v との相対誤差の上限
+constexpr double position_partial_bound = 1e-6; // 中心差分による ∂a/∂r との相対誤差の上限
+
+/**
+ * @brief 誤差を表示して上限と比較する
+ *
+ */
+bool report(const char *name, double error, double bound) {
+	std::cout << (error <= bound ? "OK   " : "FAIL ") << name << ": " << error << " (bound " << bound << ")" << std::endl;
+	return error <= bound;
+}
+
+int main() {
+	auto sw_dataset = SpaceWeather{"SW-Last5Years.csv"};
+	const auto dt = DateTime{"2023-12-31T00:00:00"};
+	if (!sw_dataset.find(dt)) {
+		std::cout << "SW-Last5Years.csv not found; skipping drag checks" << std::endl;
+		return EXIT_SUCCESS;
+	}
+
+	// 傾斜円軌道 (高度 400 km から徐々に降下)
+	const int n = 200;
+	std::vector<DateTime> epochs;
+	Eigen::Matrix3Xd position(3, n), velocity(3, n);
+	for (int i = 0; i < n; i++) {
+		const double theta = i * 0.05, radius = 6778e3 - i * 100.0, speed = std::sqrt(3.986004418e14 / radius);
+		epochs.push_back(dt + Seconds(30 * i));
+		position.col(i) = radius * Eigen::Vector3d{std::cos(theta), std::sin(theta) * 0.6, std::sin(theta) * 0.8};
+		velocity.col(i) = speed * Eigen::Vector3d{-std::sin(theta), std::cos(theta) * 0.6, std::cos(theta) * 0.8};
+	}
+
+	const DragModel drag;
+	Eigen::Matrix3Xd acceleration;
+	std::vector<DragPartials> partials(n);
+	drag.acceleration(epochs, position, velocity, ballistic_coefficient, sw_dataset, acceleration, partials);
+
+	const GeoAtmosDensity atmos(DensityUnit::KgPerM3, TemperatureUnit::Kelvin);
+	const Eigen::Vector3d omega{0, 0, constant::earth_rotation_rate};
+	double acceleration_error = 0, velocity_error = 0, position_error = 0;
+	for (int i = 0; i < n; i++) {
+		const Eci pos(epochs[i], position.col(i));
+		const Eigen::Vector3d v = velocity.col(i);
+		const Eigen::Vector3d v_rel = v - omega.cross(pos());
+		const double rho = atmos(pos, sw_dataset).density.atmosphere;
+		const Eigen::Vector3d expected = -0.5 * rho * ballistic_coefficient * v_rel.norm() * v_rel;
+		acceleration_error = std::max(acceleration_error, (acceleration.col(i) - expected).norm() / expected.norm());
+
+		Eigen::Matrix3d dv;
+		for (int j = 0; j < 3; j++) {
+			const Eigen::Vector3d h = 1e-3 * Eigen::Vector3d::Unit(j);
+			dv.col(j) = (drag.acceleration(pos, v + h, ballistic_coefficient, sw_dataset) -
+						 drag.acceleration(pos, v - h, ballistic_coefficient, sw_dataset)) /
+						2e-3;
+		}
+		velocity_error = std::max(velocity_error, (dv - partials[i].velocity).norm() / dv.norm());
+
+		Eigen::Matrix3d dr;
+		for (int j = 0; j < 3; j++) {
+			const Eigen::Vector3d h = 10.0 * Eigen::Vector3d::Unit(j);
+			dr.col(j) = (drag.acceleration(Eci(epochs[i], pos() + h), v, ballistic_coefficient, sw_dataset) -
+						 drag.acceleration(Eci(epochs[i], pos() - h), v, ballistic_coefficient, sw_dataset)) /
+						20.0;
+		}
+		position_error = std::max(position_error, (dr - partials[i].position).norm() / dr.norm());
+	}
+
+	bool ok = true;
+	ok &= report("acceleration relative error", acceleration_error, acceleration_bound);
+	ok &= report("da/dv relative error", velocity_error, velocity_partial_bound);
+	ok &= report("da/dr relative error", position_error, position_partial_bound);
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
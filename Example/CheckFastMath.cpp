@@ -0,0 +1,200 @@
+/**
+ * @file CheckFastMath.cpp
+ * @author fugu133
+ * @brief GEOATMOS_NRLMSISE_FAST_MATH の近似誤差の確認
+ * @version 0.1
+ * @date 2024-01-09
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <GeoAtmos/Core.hpp>
+
+using namespace geoatmos;
+
+constexpr double exp_bound = 5e-13;	  // fastmath::exp の相対誤差の上限
+constexpr double log_bound = 5e-14;	  // fastmath::log の誤差の上限 (max(1, |log x|) に対する比)
+constexpr double pow_bound = 1e-12;	  // fastmath::pow の相対誤差の上限 (|y log x| ≤ 20 の範囲)
+constexpr double model_bound = 1e-10; // 大気密度・温度の相対誤差の上限
+
+const auto dt = DateTime{"2023-01-01T00:00:00"};
+
+/**
+ * @brief 誤差を表示して上限と比較する
+ *
+ */
+bool report(const char *name, double error, double bound) {
+	std::cout << (error <= bound ? "OK   " : "FAIL ") << name << ": " << error << " (bound " << bound << ")" << std::endl;
+	return error <= bound;
+}
+
+/**
+ * @brief fastmath の各関数を標準ライブラリと比較する
+ *
+ */
+bool checkFunctions() {
+	std::mt19937_64 rng(1);
+	double exp_error = 0, log_error = 0, pow_error = 0;
+
+	for (double x = -708.0; x <= 709.0; x += 1.0 / 1024) {
+		exp_error = std::max(exp_error, std::abs(internal::fastmath::exp(x) / std::exp(x) - 1.0));
+	}
+
+	std::uniform_int_distribution<std::uint64_t> normal_bits(0x0010000000000000ULL, 0x7fefffffffffffffULL);
+	for (int i = 0; i < 2000000; i++) {
+		const double x = std::bit_cast<double>(normal_bits(rng));
+		const double exact = std::log(x);
+		log_error = std::max(log_error, std::abs(internal::fastmath::log(x) - exact) / std::max(1.0, std::abs(exact)));
+	}
+	for (double x = 0.5; x <= 2.0; x += 1.0 / (1 << 20)) {
+		log_error = std::max(log_error, std::abs(internal::fastmath::log(x) - std::log(x)));
+	}
+
+	std::uniform_real_distribution<double> log_base(-std::log(1e3), std::log(1e3)), exponent(-2.5, 2.5);
+	for (int i = 0; i < 2000000; i++) {
+		const double x = std::exp(log_base(rng)), y = exponent(rng);
+		pow_error = std::max(pow_error, std::abs(internal::fastmath::pow(x, y) / std::pow(x, y) - 1.0));
+	}
+
+	bool ok = true;
+	ok &= report("fastmath::exp relative error", exp_error, exp_bound);
+	ok &= report("fastmath::log error", log_error, log_bound);
+	ok &= report("fastmath::pow relative error", pow_error, pow_bound);
+	ok &= report("fastmath::exp(-1000)", internal::fastmath::exp(-1000.0), 0.0);
+	ok &= (internal::fastmath::exp(1000.0) == std::exp(1000.0)) && std::isnan(internal::fastmath::log(-1.0));
+	return ok;
+}
+
+/**
+ * @brief 全範囲の計算結果
+ *
+ */
+struct Envelope {
+	std::vector<AtmosphericParameters> params;
+	std::vector<std::uint32_t> status; // EvaluationStatus::Flag の論理和
+};
+
+/**
+ * @brief 高度・太陽活動・地磁気活動・季節・地方時・緯度の全範囲の大気パラメータを計算する
+ * @note モデル自体が計算できない組み合わせ (F10.7 が低く Ap が極端に高い場合など) は status に記録される
+ *
+ */
+Envelope evaluateEnvelope() {
+	const GeoAtmosDensity atmos;
+	const double f107s[] = {65, 150, 300};
+	const double aps[] = {0, 15, 50, 150, 400};
+	const int days[] = {0, 80, 171, 354};
+
+	Envelope envelope;
+	std::vector<Wgs84> positions;
+	std::vector<AtmosphericParameters> out;
+	std::vector<std::uint32_t> status;
+	for (double f107 : f107s) {
+		for (double ap : aps) {
+			const MagneticIndex index{ap, ap, ap, ap, ap, ap, ap};
+			positions.clear();
+			for (int day : days) {
+				for (int hour = 0; hour < 24; hour += 3) {
+					for (double lat = -80; lat <= 80; lat += 40) {
+						for (double alt = 0; alt <= 1000; alt += 10) {
+							positions.emplace_back(dt + Days(day) + Hours(hour), Degree{lat * 2}, Degree{lat}, alt * 1e3);
+						}
+					}
+				}
+			}
+			out.resize(positions.size());
+			status.resize(positions.size());
+			atmos.batch(std::span<const Wgs84>{positions}, f107, f107, index, std::span{out}, std::span{status});
+			envelope.params.insert(envelope.params.end(), out.begin(), out.end());
+			envelope.status.insert(envelope.status.end(), status.begin(), status.end());
+		}
+	}
+	return envelope;
+}
+
+/**
+ * @brief 近似を使わない計算結果との相対誤差の最大値を確認する
+ *
+ */
+bool compareEnvelope(const Envelope &envelope, const Envelope &reference) {
+	if (envelope.params.size() != reference.params.size() || envelope.status.size() != reference.status.size()) {
+		std::cout << "FAIL reference size mismatch" << std::endl;
+		return false;
+	}
+
+	auto relative = [](double a, double b) { return (a == b) ? 0.0 : std::abs(a / b - 1.0); };
+	double density_error = 0, species_error = 0, temperature_error = 0;
+	std::size_t skipped = 0, status_mismatch = 0;
+	for (std::size_t i = 0; i < envelope.params.size(); i++) {
+		if (envelope.status[i] != reference.status[i]) status_mismatch++;
+		if (envelope.status[i] != EvaluationStatus::Ok || reference.status[i] != EvaluationStatus::Ok) {
+			skipped++;
+			continue;
+		}
+
+		const auto &p = envelope.params[i], &r = reference.params[i];
+		density_error = std::max(density_error, relative(p.density.atmosphere, r.density.atmosphere));
+		for (auto d : {&Density::atomic_hydrogen, &Density::atomic_helium, &Density::atomic_nitrogen, &Density::atomic_oxygen,
+					   &Density::atomic_argon, &Density::molecular_nitrogen, &Density::molecular_oxygen, &Density::anomalous_oxygen}) {
+			species_error = std::max(species_error, relative(p.density.*d, r.density.*d));
+		}
+		temperature_error = std::max(temperature_error, relative(p.temperature.at_altitude, r.temperature.at_altitude));
+		temperature_error = std::max(temperature_error, relative(p.temperature.at_exosphere, r.temperature.at_exosphere));
+	}
+
+	std::cout << skipped << " points outside the model domain skipped" << std::endl;
+
+	bool ok = true;
+	ok &= report("status mismatches", static_cast<double>(status_mismatch), 0.0);
+	ok &= report("total mass density relative error", density_error, model_bound);
+	ok &= report("number density relative error", species_error, model_bound);
+	ok &= report("temperature relative error", temperature_error, model_bound);
+	return ok;
+}
+
+int main(int argc, char **argv) {
+	const std::string mode = (argc > 2) ? argv[1] : "";
+	if (mode != "--write" && mode != "--compare") {
+		std::cerr << "usage: " << argv[0] << " --write|--compare <reference file>" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	bool ok = checkFunctions();
+	const auto envelope = evaluateEnvelope();
+	const std::size_t n = envelope.params.size();
+	std::cout << n << " envelope points" << std::endl;
+
+	if (mode == "--write") {
+		if (internal::nrlmsise_fast_math) {
+			std::cerr << "the reference must be written without GEOATMOS_NRLMSISE_FAST_MATH" << std::endl;
+			return EXIT_FAILURE;
+		}
+		std::ofstream ofs(argv[2], std::ios::binary);
+		ofs.write(reinterpret_cast<const char *>(envelope.params.data()), n * sizeof(AtmosphericParameters));
+		ofs.write(reinterpret_cast<const char *>(envelope.status.data()), n * sizeof(std::uint32_t));
+	} else {
+		// 参照ファイルは同じ格子で書き出したもの (要素数は同じ)
+		Envelope reference{std::vector<AtmosphericParameters>(n), std::vector<std::uint32_t>(n)};
+		std::ifstream ifs(argv[2], std::ios::binary);
+		ifs.read(reinterpret_cast<char *>(reference.params.data()), n * sizeof(AtmosphericParameters));
+		ifs.read(reinterpret_cast<char *>(reference.status.data()), n * sizeof(std::uint32_t));
+		if (!ifs) {
+			std::cerr << "failed to read " << argv[2] << std::endl;
+			return EXIT_FAILURE;
+		}
+		ok &= compareEnvelope(envelope, reference);
+	}
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,34 @@
+/**
+ * @file ConvertSwDataset.cpp
+ * @author fugu133
+ * @brief 宇宙天気データベースを CSV 形式からバイナリ形式に変換する
+ * @version 0.1
+ * @date 2024-01-07
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <GeoAtmos/Core.hpp>
+#include <iostream>
+
+using namespace geoatmos;
+
+int main(int argc, char** argv) {
+	const std::string src = (argc > 1) ? argv[1] : "SW-Last5Years.csv";
+	const std::string dst = (argc > 2) ? argv[2] : "SW-Last5Years.bin";
+
+	SpaceWeather sw_dataset(src);
+	if (!sw_dataset.writeBinary(dst)) {
+		std::cerr << "Failed to write " << dst << std::endl;
+		return 1;
+	}
+
+	// 変換結果を読み直して確認する
+	SpaceWeather sw_binary(dst);
+	auto dt = DateTime{"2023-12-31T00:00:00"};
+	std::cout << "AP +00h (CSV): " << sw_dataset.apIndex(dt) << std::endl;
+	std::cout << "AP +00h (BIN): " << sw_binary.apIndex(dt) << std::endl;
+	std::cout << "F10.7 adj (CSV): " << sw_dataset.adjustedF107(dt) << std::endl;
+	std::cout << "F10.7 adj (BIN): " << sw_binary.adjustedF107(dt) << std::endl;
+}
@@ -9,5 +9,7 @@
  *
  */
 
+#include "src/DensityGrid.hpp"
+#include "src/Drag.hpp"
 #include "src/GeoAtmosDensity.hpp"
 #include "src/SpaceWeather.hpp"
\ No newline at end of file
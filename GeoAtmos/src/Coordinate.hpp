@@ -11,7 +11,12 @@
 
 #pragma once
 
+#include <array>
+#include <initializer_list>
 #include <iostream>
+#include <limits>
+#include <span>
+#include <type_traits>
 
 #include "../../Eigen/Geometry"
 #include "AngleHelper.hpp"
@@ -65,22 +70,214 @@ class EquatorialSpherical;
 using EquatorialCartesian = Eci;
 class Topocentric;
 
+namespace internal {
+	class FrameRotationCache;
+} // namespace internal
+
+/**
+ * @brief 大量の点を保持するための ECI 座標 (時刻は DateTime のティック数, 位置 [m])
+ * @note 仮想関数や型情報を持たない値型のため, 配列をそのまま memcpy や mmap で読み書きできる
+ */
+struct EciSample {
+	std::int64_t ticks;
+	double x, y, z;
+
+	DateTime epoch() const { return DateTime(ticks); }
+	Eci toEci() const;
+	Ecef toEcef() const;
+	Wgs84 toWgs84() const;
+};
+
+/**
+ * @brief 大量の点を保持するための ECEF 座標 (時刻は DateTime のティック数, 位置 [m])
+ * @note 仮想関数や型情報を持たない値型のため, 配列をそのまま memcpy や mmap で読み書きできる
+ */
+struct EcefSample {
+	std::int64_t ticks;
+	double x, y, z;
+
+	DateTime epoch() const { return DateTime(ticks); }
+	Ecef toEcef() const;
+	Eci toEci() const;
+	Wgs84 toWgs84() const;
+};
+
+/**
+ * @brief 大量の点を保持するための WGS84 測地座標 (時刻は DateTime のティック数, 経度・緯度 [rad], 楕円体高 [m])
+ * @note 仮想関数や型情報を持たない値型のため, 配列をそのまま memcpy や mmap で読み書きできる.
+ *       GeoAtmosDensity に Wgs84 と同じように渡せる
+ */
+struct Wgs84Sample {
+	std::int64_t ticks;
+	double longitude, latitude, altitude;
+
+	DateTime epoch() const { return DateTime(ticks); }
+	Wgs84 toWgs84() const;
+	Ecef toEcef() const;
+};
+
+static_assert(std::is_trivially_copyable_v<EciSample> && std::is_standard_layout_v<EciSample> && sizeof(EciSample) == 32);
+static_assert(std::is_trivially_copyable_v<EcefSample> && std::is_standard_layout_v<EcefSample> && sizeof(EcefSample) == 32);
+static_assert(std::is_trivially_copyable_v<Wgs84Sample> && std::is_standard_layout_v<Wgs84Sample> && sizeof(Wgs84Sample) == 32);
+
+/**
+ * @brief ある時刻の ECI と ECEF の間の回転 (地球自転)
+ * @note グリニッジ恒星時は構築時に1回だけ計算するため, 同じ時刻の多数のベクトルの変換に使い回せる
+ */
+class FrameRotation {
+  public:
+	explicit FrameRotation(const DateTime& epoch);
+
+	const DateTime& epoch() const { return m_epoch; }
+
+	/**
+	 * @brief ECI 座標のベクトルを ECEF 座標に回転する
+	 *
+	 */
+	Eigen::Vector3d toEcef(const Eigen::Vector3d& eci) const {
+		return Eigen::Vector3d{eci.x() * m_cos_theta + eci.y() * m_sin_theta, -eci.x() * m_sin_theta + eci.y() * m_cos_theta, eci.z()};
+	}
+
+	/**
+	 * @brief ECEF 座標のベクトルを ECI 座標に回転する
+	 *
+	 */
+	Eigen::Vector3d toEci(const Eigen::Vector3d& ecef) const {
+		return Eigen::Vector3d{ecef.x() * m_cos_theta - ecef.y() * m_sin_theta, ecef.x() * m_sin_theta + ecef.y() * m_cos_theta, ecef.z()};
+	}
+
+	/**
+	 * @brief ECI 座標の配列 (各列が1点 [m]) をすべてこの時刻の ECEF 座標に回転する
+	 * @note ecef は必要に応じて 3 x n に確保し直される
+	 */
+	void toEcef(const Eigen::Matrix3Xd& eci, Eigen::Matrix3Xd& ecef) const;
+
+	/**
+	 * @brief ECEF 座標の配列 (各列が1点 [m]) をすべてこの時刻の ECI 座標に回転する
+	 * @note eci は必要に応じて 3 x n に確保し直される
+	 */
+	void toEci(const Eigen::Matrix3Xd& ecef, Eigen::Matrix3Xd& eci) const;
+
+  private:
+	friend class internal::FrameRotationCache;
+
+	FrameRotation(const DateTime& epoch, double cos_theta, double sin_theta)
+	  : m_epoch(epoch), m_cos_theta(cos_theta), m_sin_theta(sin_theta) {}
+
+	DateTime m_epoch;
+	double m_cos_theta;
+	double m_sin_theta;
+};
+
+/**
+ * @brief ある時刻の黄道座標系と赤道座標系の間の回転 (黄道傾斜角)
+ * @note 黄道傾斜角は構築時に1回だけ計算するため, 同じ時刻の多数の点の変換に使い回せる
+ */
+class EclipticFrame {
+  public:
+	explicit EclipticFrame(const DateTime& epoch);
+
+	const DateTime& epoch() const { return m_epoch; }
+
+	/**
+	 * @brief 黄道傾斜角を取得する
+	 *
+	 */
+	Angle obliquity() const { return Radian(m_epsilon); }
+
+	/**
+	 * @brief 黄道直交座標のベクトルを赤道直交座標 (ECI) に回転する
+	 *
+	 */
+	Eigen::Vector3d toEci(const Eigen::Vector3d& ecliptic) const {
+		return Eigen::Vector3d{ecliptic.x(), ecliptic.y() * m_cos_epsilon - ecliptic.z() * m_sin_epsilon,
+							   ecliptic.y() * m_sin_epsilon + ecliptic.z() * m_cos_epsilon};
+	}
+
+	/**
+	 * @brief 黄経・黄緯 [rad] を赤経・赤緯 [rad] に変換する
+	 *
+	 */
+	void toEquatorialSpherical(double longitude, double latitude, double& right_ascension, double& declination) const {
+		right_ascension = AngleHelper::wrapRadian(
+		  std::atan2(std::sin(longitude) * m_cos_epsilon - std::tan(latitude) * m_sin_epsilon, std::cos(longitude)));
+		declination = std::asin(std::sin(latitude) * m_cos_epsilon + std::cos(latitude) * m_sin_epsilon * std::sin(longitude));
+	}
+
+	/**
+	 * @brief 赤経・赤緯 [rad] を黄経・黄緯 [rad] に変換する
+	 *
+	 */
+	void toEclipticSpherical(double right_ascension, double declination, double& longitude, double& latitude) const {
+		longitude = AngleHelper::wrapRadian(
+		  std::atan2(std::sin(right_ascension) * m_cos_epsilon + std::tan(declination) * m_sin_epsilon, std::cos(right_ascension)));
+		latitude = std::asin(std::sin(declination) * m_cos_epsilon - std::cos(declination) * m_sin_epsilon * std::sin(right_ascension));
+	}
+
+	/**
+	 * @brief 黄道直交座標の配列 (各列が1点) をすべてこの時刻の赤道直交座標 (ECI) に回転する
+	 * @note eci は必要に応じて 3 x n に確保し直される
+	 */
+	void toEci(const Eigen::Matrix3Xd& ecliptic, Eigen::Matrix3Xd& eci) const;
+
+	/**
+	 * @brief 黄経・黄緯 [rad] の配列をすべてこの時刻の赤経・赤緯 [rad] に変換する
+	 *
+	 */
+	void toEquatorialSpherical(std::span<const double> longitude, std::span<const double> latitude, std::span<double> right_ascension,
+							   std::span<double> declination) const;
+
+	/**
+	 * @brief 赤経・赤緯 [rad] の配列をすべてこの時刻の黄経・黄緯 [rad] に変換する
+	 *
+	 */
+	void toEclipticSpherical(std::span<const double> right_ascension, std::span<const double> declination, std::span<double> longitude,
+							 std::span<double> latitude) const;
+
+  private:
+	DateTime m_epoch;
+	double m_epsilon;
+	double m_cos_epsilon;
+	double m_sin_epsilon;
+};
+
 class Eci : public CoordinateBase<Eigen::Vector3d> {
   public:
 	Eci() : CoordinateBase(DateTime::now(), Eigen::Vector3d::Zero(), CoordinateType::Eci) {}
 	Eci(const DateTime& dt, const Eigen::Vector3d& d) : CoordinateBase(dt, d, CoordinateType::Eci) {}
 	Eci(const DateTime& dt, double x, double y, double z) : CoordinateBase(dt, Eigen::Vector3d{x, y, z}, CoordinateType::Eci) {}
+	explicit Eci(const EciSample& s) : CoordinateBase(DateTime(s.ticks), Eigen::Vector3d{s.x, s.y, s.z}, CoordinateType::Eci) {}
 
 	const double& x() const { return m_data.x(); }
 	const double& y() const { return m_data.y(); }
 	const double& z() const { return m_data.z(); }
 
 	Eci toEci() const { return *this; }
+	EciSample sample() const { return EciSample{m_epoch.ticks(), x(), y(), z()}; }
 	EquatorialSpherical toEquatorialSpherical() const;
 	Ecef toEcef() const;
 	GeocentricSpherical toGeocentricSpherical() const;
 	Wgs84 toWgs84() const;
 
+	/**
+	 * @brief ECI 座標の配列 (各列が1点 [m]) を ECEF 座標の配列に一括変換する
+	 * @note 最近現れた時刻の回転は FrameRotation として再利用する. ecef は必要に応じて 3 x n に確保し直される
+	 */
+	static void toEcef(std::span<const DateTime> epochs, const Eigen::Matrix3Xd& eci, Eigen::Matrix3Xd& ecef);
+
+	/**
+	 * @brief ECI 座標の配列 (各列が1点 [m]) を WGS84 測地座標 (経度, 緯度 [rad], 楕円体高 [m]) の配列に一括変換する
+	 * @note 最近現れた時刻の回転は FrameRotation として再利用する. 中間の ECEF 座標は保持しない
+	 */
+	static void toWgs84(std::span<const DateTime> epochs, const Eigen::Matrix3Xd& eci, std::span<double> longitude,
+						std::span<double> latitude, std::span<double> altitude);
+
+	/**
+	 * @brief EciSample の配列を Wgs84Sample の配列に一括変換する
+	 * @note 最近現れた時刻の回転は FrameRotation として再利用する
+	 */
+	static void toWgs84(std::span<const EciSample> eci, std::span<Wgs84Sample> wgs84);
+
 	std::string toString() const override {
 		std::stringstream ss;
 		ss << "ECI(t = " << m_epoch.toString() << ", x = " << m_data.x() << " [m], y = " << m_data.y() << " [m], z = " << m_data.z()
@@ -99,6 +296,7 @@ class Ecef : public CoordinateBase<Eigen::Vector3d> {
 	Ecef() : CoordinateBase(DateTime::now(), Eigen::Vector3d::Zero(), CoordinateType::Ecef) {}
 	Ecef(const DateTime& dt, const Eigen::Vector3d& d) : CoordinateBase(dt, d, CoordinateType::Ecef) {}
 	Ecef(const DateTime& dt, double x, double y, double z) : CoordinateBase(dt, Eigen::Vector3d{x, y, z}, CoordinateType::Ecef) {}
+	explicit Ecef(const EcefSample& s) : CoordinateBase(DateTime(s.ticks), Eigen::Vector3d{s.x, s.y, s.z}, CoordinateType::Ecef) {}
 
 	const double& x() const { return m_data.x(); }
 	const double& y() const { return m_data.y(); }
@@ -107,9 +305,40 @@ class Ecef : public CoordinateBase<Eigen::Vector3d> {
 	Eci toEci() const;
 	EquatorialSpherical toEquatorialSpherical() const;
 	Ecef toEcef() const { return *this; }
+	EcefSample sample() const { return EcefSample{m_epoch.ticks(), x(), y(), z()}; }
 	GeocentricSpherical toGeocentricSpherical() const;
 	Wgs84 toWgs84() const;
 
+	/**
+	 * @brief ECEF 座標 (x, y, z [m]) の配列を WGS84 測地座標 (経度, 緯度 [rad], 楕円体高 [m]) の配列に一括変換する
+	 * @note 反復を含まない閉形式で計算するため, 1点あたりの計算量は位置によらず一定
+	 */
+	static void toWgs84(std::span<const double> x, std::span<const double> y, std::span<const double> z, std::span<double> longitude,
+						std::span<double> latitude, std::span<double> altitude);
+
+	/**
+	 * @brief ECEF 座標の配列 (各列が1点 [m]) を WGS84 測地座標 (経度, 緯度 [rad], 楕円体高 [m]) の配列に一括変換する
+	 */
+	static void toWgs84(const Eigen::Matrix3Xd& ecef, std::span<double> longitude, std::span<double> latitude, std::span<double> altitude);
+
+	/**
+	 * @brief EcefSample の配列を Wgs84Sample の配列に一括変換する
+	 *
+	 */
+	static void toWgs84(std::span<const EcefSample> ecef, std::span<Wgs84Sample> wgs84);
+
+	/**
+	 * @brief ECEF 座標の配列 (各列が1点 [m]) を ECI 座標の配列に一括変換する
+	 * @note 最近現れた時刻の回転は FrameRotation として再利用する. eci は必要に応じて 3 x n に確保し直される
+	 */
+	static void toEci(std::span<const DateTime> epochs, const Eigen::Matrix3Xd& ecef, Eigen::Matrix3Xd& eci);
+
+	/**
+	 * @brief ECEF 座標の配列 (各列が1点 [m]) を地心球座標 (経度, 地心緯度 [rad], 地心距離 [m]) の配列に一括変換する
+	 */
+	static void toGeocentricSpherical(const Eigen::Matrix3Xd& ecef, std::span<double> longitude, std::span<double> latitude,
+									  std::span<double> radius);
+
 	std::string toString() const override {
 		std::stringstream ss;
 		ss << "ECEF(t =" << m_epoch.toString() << ", x = " << m_data.x() << " [m], y = " << m_data.y() << " [m], z =" << m_data.z()
@@ -174,6 +403,8 @@ class Wgs84 : public CoordinateBase<Wgs84Position> {
 	Wgs84(const DateTime& dt, const Wgs84Position& d) : CoordinateBase(dt, d, CoordinateType::Wgs84) {}
 	Wgs84(const DateTime& dt, const Angle& lon, const Angle& lat, double alt)
 	  : CoordinateBase(dt, Wgs84Position{lon, lat, alt}, CoordinateType::Wgs84) {}
+	explicit Wgs84(const Wgs84Sample& s)
+	  : CoordinateBase(DateTime(s.ticks), Wgs84Position{Radian(s.longitude), Radian(s.latitude), s.altitude}, CoordinateType::Wgs84) {}
 	// Wgs84(const DateTime& dt, double lon, double lat, double alt)
 	//   : CoordinateBase(dt, Wgs84Position{lon, lat, alt}, CoordinateType::Wgs84) {}
 
@@ -186,6 +417,16 @@ class Wgs84 : public CoordinateBase<Wgs84Position> {
 	Ecef toEcef() const;
 	GeocentricSpherical toGeocentricSpherical() const;
 	Wgs84 toWgs84() const { return *this; }
+	Wgs84Sample sample() const {
+		return Wgs84Sample{m_epoch.ticks(), m_data.longitude.radians(), m_data.latitude.radians(), m_data.altitude};
+	}
+
+	/**
+	 * @brief WGS84 測地座標 (経度, 緯度 [rad], 楕円体高 [m]) の配列を ECEF 座標の配列 (各列が1点 [m]) に一括変換する
+	 * @note ecef は必要に応じて 3 x n に確保し直される
+	 */
+	static void toEcef(std::span<const double> longitude, std::span<const double> latitude, std::span<const double> altitude,
+					   Eigen::Matrix3Xd& ecef);
 
 	std::string toString() const override {
 		std::stringstream ss;
@@ -222,6 +463,13 @@ class EclipticSpherical : public CoordinateBase<EclipticSphericalPosition> {
 	Eci toEci() const;
 	EquatorialSpherical toEquatorialSpherical() const;
 
+	/**
+	 * @brief 黄経・黄緯 [rad] の配列を赤経・赤緯 [rad] の配列に一括変換する
+	 * @note 直前の点と同じ時刻では EclipticFrame を再利用する
+	 */
+	static void toEquatorialSpherical(std::span<const DateTime> epochs, std::span<const double> longitude, std::span<const double> latitude,
+									  std::span<double> right_ascension, std::span<double> declination);
+
 	std::string toString() const override {
 		std::stringstream ss;
 		ss << "EclipticSpherical(t = " << m_epoch.toString() << ", Lon = " << m_data.ecliptic_longitude.degrees()
@@ -248,6 +496,12 @@ struct EclipticCartesian : public CoordinateBase<Eigen::Vector3d> {
 	EclipticSpherical toEclipticSpherical() const;
 	Eci toEci() const;
 
+	/**
+	 * @brief 黄道直交座標の配列 (各列が1点) を赤道直交座標 (ECI) の配列に一括変換する
+	 * @note 直前の点と同じ時刻では EclipticFrame を再利用する. eci は必要に応じて 3 x n に確保し直される
+	 */
+	static void toEci(std::span<const DateTime> epochs, const Eigen::Matrix3Xd& ecliptic, Eigen::Matrix3Xd& eci);
+
 	std::string toString() const override {
 		std::stringstream ss;
 		ss << "EclipticCartesian(t = " << m_epoch.toString() << ", x = " << m_data.x() << " [m], y = " << m_data.y()
@@ -291,6 +545,13 @@ struct EquatorialSpherical : public CoordinateBase<EquatorialSphericalPosition>
 	EclipticSpherical toEclipticSpherical() const;
 	Eci toEci() const;
 
+	/**
+	 * @brief 赤経・赤緯 [rad] の配列を黄経・黄緯 [rad] の配列に一括変換する
+	 * @note 直前の点と同じ時刻では EclipticFrame を再利用する
+	 */
+	static void toEclipticSpherical(std::span<const DateTime> epochs, std::span<const double> right_ascension,
+									std::span<const double> declination, std::span<double> longitude, std::span<double> latitude);
+
 	friend auto operator<<(std::ostream& os, const EquatorialSpherical& equatorial) -> std::ostream& {
 		os << equatorial.toString();
 		return os;
@@ -327,15 +588,113 @@ class Topocentric : public CoordinateBase<TopocentricPosition> {
 	}
 };
 
+inline FrameRotation::FrameRotation(const DateTime& epoch) : m_epoch(epoch) {
+	const double theta = epoch.greenwichSiderealTime().radians();
+	m_cos_theta = std::cos(theta);
+	m_sin_theta = std::sin(theta);
+}
+
+inline void FrameRotation::toEcef(const Eigen::Matrix3Xd& eci, Eigen::Matrix3Xd& ecef) const {
+	ecef.resize(3, eci.cols());
+	for (Eigen::Index i = 0; i < eci.cols(); i++) ecef.col(i) = toEcef(eci.col(i));
+}
+
+inline void FrameRotation::toEci(const Eigen::Matrix3Xd& ecef, Eigen::Matrix3Xd& eci) const {
+	eci.resize(3, ecef.cols());
+	for (Eigen::Index i = 0; i < ecef.cols(); i++) eci.col(i) = toEci(ecef.col(i));
+}
+
 inline Ecef Eci::toEcef() const {
-	const double theta = m_epoch.greenwichSiderealTime().radians();
-	const double x = m_data.x() * std::cos(theta) + m_data.y() * std::sin(theta);
-	const double y = -m_data.x() * std::sin(theta) + m_data.y() * std::cos(theta);
-	const double z = m_data.z();
-	return Ecef(m_epoch, Eigen::Vector3d{x, y, z});
+	return Ecef(m_epoch, FrameRotation(m_epoch).toEcef(m_data));
+}
+
+namespace internal {
+	/**
+	 * @brief 座標配列の要素数が一致することを確認する
+	 *
+	 */
+	inline void checkCoordinateArraySize(std::size_t n, std::initializer_list<std::size_t> sizes) {
+		for (std::size_t size : sizes) {
+			if (size != n) throw AtmosModelException("Coordinate array sizes do not match.", AtmosModelException::InvalidValue);
+		}
+	}
+
+	/**
+	 * @brief 最近使った時刻の FrameRotation を保持する小さなキャッシュ (時刻のハッシュによるダイレクトマップ)
+	 * @note 衛星ごとに時刻が並ぶ配列 (t0, t1, ..., t0, t1, ...) のように, 同じ時刻が離れて現れる場合も再計算しない
+	 */
+	class FrameRotationCache {
+	  public:
+		static constexpr std::size_t capacity = 64;
+
+		FrameRotationCache() { m_ticks.fill(std::numeric_limits<std::int64_t>::min()); }
+
+		FrameRotation get(const DateTime& epoch) {
+			const std::int64_t ticks = epoch.ticks();
+			const std::size_t k = (static_cast<std::uint64_t>(ticks) * 0x9e3779b97f4a7c15ULL) >> 58; // 上位 6 bit
+			if (m_ticks[k] != ticks) {
+				const FrameRotation rotation(epoch);
+				m_ticks[k] = ticks;
+				m_cos[k] = rotation.m_cos_theta;
+				m_sin[k] = rotation.m_sin_theta;
+				return rotation;
+			}
+			return FrameRotation(epoch, m_cos[k], m_sin[k]);
+		}
+
+	  private:
+		std::array<std::int64_t, capacity> m_ticks;
+		std::array<double, capacity> m_cos;
+		std::array<double, capacity> m_sin;
+	};
+
+	/**
+	 * @brief ECEF 直交座標を WGS84 測地座標に変換する (Vermeille (2011) の閉形式解)
+	 * @note 反復と分岐を含まないため計算量は一定. 地球中心から約 43 km 以内の点には使えない
+	 */
+	inline void ecefToWgs84(double x, double y, double z, double& lon, double& lat, double& alt) {
+		constexpr double a = constant::wgs84_a;
+		constexpr double b = constant::wgs84_b;
+		constexpr double e2 = (a * a - b * b) / (a * a);
+		constexpr double e4 = e2 * e2;
+
+		const double rho2 = x * x + y * y;
+		const double p = rho2 / (a * a);
+		const double q = (1 - e2) * z * z / (a * a);
+		const double r = (p + q - e4) / 6;
+		const double s = e4 * p * q / (4 * r * r * r);
+		const double t = std::cbrt(1 + s + std::sqrt(s * (2 + s)));
+		const double u = r * (1 + t + 1 / t);
+		const double v = std::sqrt(u * u + e4 * q);
+		const double w = e2 * (u + v - q) / (2 * v);
+		const double k = std::sqrt(u + v + w * w) - w;
+		const double d = k * std::sqrt(rho2) / (k + e2);
+		const double dz = std::sqrt(d * d + z * z);
+
+		lon = std::atan2(y, x);
+		lat = 2 * std::atan2(z, d + dz);
+		alt = (k + e2 - 1) / k * dz;
+	}
+} // namespace internal
+
+inline void Eci::toEcef(std::span<const DateTime> epochs, const Eigen::Matrix3Xd& eci, Eigen::Matrix3Xd& ecef) {
+	internal::checkCoordinateArraySize(eci.cols(), {epochs.size()});
+	ecef.resize(3, eci.cols());
+	internal::FrameRotationCache cache;
+	for (Eigen::Index i = 0; i < eci.cols(); i++) ecef.col(i) = cache.get(epochs[i]).toEcef(eci.col(i));
 }
 
-GeocentricSpherical Eci::toGeocentricSpherical() const {
+inline void Eci::toWgs84(std::span<const DateTime> epochs, const Eigen::Matrix3Xd& eci, std::span<double> longitude,
+						 std::span<double> latitude, std::span<double> altitude) {
+	internal::checkCoordinateArraySize(eci.cols(), {epochs.size(), longitude.size(), latitude.size(), altitude.size()});
+	internal::FrameRotationCache cache;
+	for (Eigen::Index i = 0; i < eci.cols(); i++) {
+		const Eigen::Vector3d ecef = cache.get(epochs[i]).toEcef(eci.col(i));
+		internal::ecefToWgs84(ecef.x(), ecef.y(), ecef.z(), longitude[i], latitude[i], altitude[i]);
+	}
+}
+
+inline GeocentricSpherical Eci::toGeocentricSpherical() const {
 	return toEcef().toGeocentricSpherical();
 }
 
@@ -351,12 +710,14 @@ inline EquatorialSpherical Eci::toEquatorialSpherical() const {
 }
 
 inline Eci Ecef::toEci() const {
-	const double theta = m_epoch.greenwichSiderealTime().radians();
-	const double x = m_data.x() * std::cos(theta) - m_data.y() * std::sin(theta);
-	const double y = m_data.x() * std::sin(theta) + m_data.y() * std::cos(theta);
-	const double z = m_data.z();
+	return Eci(m_epoch, FrameRotation(m_epoch).toEci(m_data));
+}
 
-	return Eci(m_epoch, Eigen::Vector3d{x, y, z});
+inline void Ecef::toEci(std::span<const DateTime> epochs, const Eigen::Matrix3Xd& ecef, Eigen::Matrix3Xd& eci) {
+	internal::checkCoordinateArraySize(ecef.cols(), {epochs.size()});
+	eci.resize(3, ecef.cols());
+	internal::FrameRotationCache cache;
+	for (Eigen::Index i = 0; i < ecef.cols(); i++) eci.col(i) = cache.get(epochs[i]).toEci(ecef.col(i));
 }
 
 inline Ecef GeocentricSpherical::toEcef() const {
@@ -380,28 +741,35 @@ inline GeocentricSpherical Ecef::toGeocentricSpherical() const {
 	return GeocentricSpherical(m_epoch, GeocentricSphericalPosition{Radian(phi), Radian(theta), r});
 }
 
-inline Wgs84 Ecef::toWgs84() const {
-	constexpr double a = constant::wgs84_a;
-	constexpr double b = constant::wgs84_b;
-	constexpr double e2 = (a * a - b * b) / (a * a);
-
-	const double p = std::sqrt(m_data.x() * m_data.x() + m_data.y() * m_data.y());
+inline void Ecef::toGeocentricSpherical(const Eigen::Matrix3Xd& ecef, std::span<double> longitude, std::span<double> latitude,
+										std::span<double> radius) {
+	internal::checkCoordinateArraySize(ecef.cols(), {longitude.size(), latitude.size(), radius.size()});
+	for (Eigen::Index i = 0; i < ecef.cols(); i++) {
+		const double x = ecef(0, i), y = ecef(1, i), z = ecef(2, i);
+		latitude[i] = std::atan2(z, std::sqrt(x * x + y * y));
+		longitude[i] = std::atan2(y, x);
+		radius[i] = ecef.col(i).norm();
+	}
+}
 
-	double phi = std::atan2(p, m_data.z()); // geocentric latitude
-	double lat = phi;
-	std::int32_t i = 0;
-	do {
-		phi = lat;
-		const double sin_phi = std::sin(phi);
-		const double N = a / std::sqrt(1 - e2 * sin_phi * sin_phi);
-		lat = std::atan2(m_data.z() + N * e2 * sin_phi, p);
-		i++;
-	} while (std::abs(lat - phi) > 1e-10 && i < 10); // 4回くらいで収束する
+inline Wgs84 Ecef::toWgs84() const {
+	double lon, lat, alt;
+	internal::ecefToWgs84(m_data.x(), m_data.y(), m_data.z(), lon, lat, alt);
+	return Wgs84(m_epoch, Wgs84Position{Radian(lon), Radian(lat), alt});
+}
 
-	const double lon = std::atan2(m_data.y(), m_data.x());
-	const double alt = p / std::cos(phi) - a / std::sqrt(1 - e2 * std::sin(phi) * std::sin(phi));
+inline void Ecef::toWgs84(std::span<const double> x, std::span<const double> y, std::span<const double> z, std::span<double> longitude,
+						  std::span<double> latitude, std::span<double> altitude) {
+	internal::checkCoordinateArraySize(x.size(), {y.size(), z.size(), longitude.size(), latitude.size(), altitude.size()});
+	for (std::size_t i = 0; i < x.size(); i++) internal::ecefToWgs84(x[i], y[i], z[i], longitude[i], latitude[i], altitude[i]);
+}
 
-	return Wgs84(m_epoch, Wgs84Position{Radian(lon), Radian(lat), alt});
+inline void Ecef::toWgs84(const Eigen::Matrix3Xd& ecef, std::span<double> longitude, std::span<double> latitude,
+						  std::span<double> altitude) {
+	internal::checkCoordinateArraySize(ecef.cols(), {longitude.size(), latitude.size(), altitude.size()});
+	for (Eigen::Index i = 0; i < ecef.cols(); i++) {
+		internal::ecefToWgs84(ecef(0, i), ecef(1, i), ecef(2, i), longitude[i], latitude[i], altitude[i]);
+	}
 }
 
 inline EquatorialSpherical Ecef::toEquatorialSpherical() const {
@@ -433,6 +801,25 @@ inline Ecef Wgs84::toEcef() const {
 	return Ecef(m_epoch, Eigen::Vector3d{x, y, z});
 }
 
+inline void Wgs84::toEcef(std::span<const double> longitude, std::span<const double> latitude, std::span<const double> altitude,
+						   Eigen::Matrix3Xd& ecef) {
+	constexpr double a = constant::wgs84_a;
+	constexpr double b = constant::wgs84_b;
+	constexpr double e2 = 1 - b * b / (a * a);
+	internal::checkCoordinateArraySize(longitude.size(), {latitude.size(), altitude.size()});
+	ecef.resize(3, longitude.size());
+	for (std::size_t i = 0; i < longitude.size(); i++) {
+		const double cos_phi = std::cos(latitude[i]);
+		const double sin_phi = std::sin(latitude[i]);
+		const double cos_theta = std::cos(longitude[i]);
+		const double sin_theta = std::sin(longitude[i]);
+		const double N = a / std::sqrt(1 - e2 * sin_phi * sin_phi);
+		ecef(0, i) = (N + altitude[i]) * cos_phi * cos_theta;
+		ecef(1, i) = (N + altitude[i]) * cos_phi * sin_theta;
+		ecef(2, i) = (N * (1 - e2) + altitude[i]) * sin_phi;
+	}
+}
+
 inline GeocentricSpherical Wgs84::toGeocentricSpherical() const {
 	return toEcef().toGeocentricSpherical();
 }
@@ -445,33 +832,81 @@ inline EquatorialSpherical Wgs84::toEquatorialSpherical() const {
 	return toEci().toEquatorialSpherical();
 }
 
-inline EquatorialSpherical EclipticSpherical::toEquatorialSpherical() const {
-	const double T = (m_epoch.j2000() + m_epoch.deltaT().totalDays()) / constant::jd_century;
+inline EclipticFrame::EclipticFrame(const DateTime& epoch) : m_epoch(epoch) {
+	const double T = (epoch.j2000() + epoch.deltaT().totalDays()) / constant::jd_century;
 	const double Omega = AngleHelper::degreeToWrapRadian(125.04 - 1934.136 * T); // Longitude of ascending node
-	const double epsilon = AngleHelper::degreeToWrapRadian(23 + (26 + Polynomial::deg3(T, 21.448, 46.8150, 0.00059, -0.001813) / 60) / 60 +
-														   0.00256 * std::cos(Omega)); // Obliquity of the ecliptic
-
-	const double alpha = AngleHelper::wrapRadian(
-	  std::atan2(m_data.ecliptic_longitude.sin() * std::cos(epsilon) - m_data.ecliptic_latitude.tan() * std::sin(epsilon),
-				 m_data.ecliptic_longitude.cos()));
-	const double delta = std::asin(m_data.ecliptic_latitude.sin() * std::cos(epsilon) +
-								   m_data.ecliptic_latitude.cos() * std::sin(epsilon) * m_data.ecliptic_longitude.sin());
+	m_epsilon = AngleHelper::degreeToWrapRadian(23 + (26 + Polynomial::deg3(T, 21.448, 46.8150, 0.00059, -0.001813) / 60) / 60 +
+												0.00256 * std::cos(Omega)); // Obliquity of the ecliptic
+	m_cos_epsilon = std::cos(m_epsilon);
+	m_sin_epsilon = std::sin(m_epsilon);
+}
+
+inline void EclipticFrame::toEci(const Eigen::Matrix3Xd& ecliptic, Eigen::Matrix3Xd& eci) const {
+	eci.resize(3, ecliptic.cols());
+	for (Eigen::Index i = 0; i < ecliptic.cols(); i++) eci.col(i) = toEci(ecliptic.col(i));
+}
+
+inline void EclipticFrame::toEquatorialSpherical(std::span<const double> longitude, std::span<const double> latitude,
+												 std::span<double> right_ascension, std::span<double> declination) const {
+	internal::checkCoordinateArraySize(longitude.size(), {latitude.size(), right_ascension.size(), declination.size()});
+	for (std::size_t i = 0; i < longitude.size(); i++) toEquatorialSpherical(longitude[i], latitude[i], right_ascension[i], declination[i]);
+}
+
+inline void EclipticFrame::toEclipticSpherical(std::span<const double> right_ascension, std::span<const double> declination,
+											   std::span<double> longitude, std::span<double> latitude) const {
+	internal::checkCoordinateArraySize(right_ascension.size(), {declination.size(), longitude.size(), latitude.size()});
+	for (std::size_t i = 0; i < right_ascension.size(); i++) {
+		toEclipticSpherical(right_ascension[i], declination[i], longitude[i], latitude[i]);
+	}
+}
+
+namespace internal {
+	/**
+	 * @brief 各時刻の EclipticFrame を f(i, frame) に渡す
+	 * @note 直前の点と同じ時刻では再計算しない
+	 */
+	template <class F>
+	inline void forEachEclipticFrame(std::span<const DateTime> epochs, F&& f) {
+		if (epochs.empty()) return;
+
+		EclipticFrame frame(epochs[0]);
+		for (std::size_t i = 0; i < epochs.size(); i++) {
+			if (epochs[i].ticks() != frame.epoch().ticks()) frame = EclipticFrame(epochs[i]);
+			f(i, frame);
+		}
+	}
+} // namespace internal
+
+inline EquatorialSpherical EclipticSpherical::toEquatorialSpherical() const {
+	double alpha, delta;
+	EclipticFrame(m_epoch).toEquatorialSpherical(m_data.ecliptic_longitude.radians(), m_data.ecliptic_latitude.radians(), alpha, delta);
 	return EquatorialSpherical(m_epoch, EquatorialSphericalPosition{Radian(alpha), Radian(delta), m_data.distance});
 }
 
-inline EclipticSpherical EquatorialSpherical::toEclipticSpherical() const {
-	const double T = (m_epoch.j2000() + m_epoch.deltaT().totalDays()) / constant::jd_century;
-	const double Omega = AngleHelper::degreeToWrapRadian(125.04 - 1934.136 * T); // Longitude of ascending node
-	const double epsilon = AngleHelper::degreeToWrapRadian(23 + (26 + Polynomial::deg3(T, 21.448, 46.8150, 0.00059, -0.001813) / 60) / 60 +
-														   0.00256 * std::cos(Omega)); // Obliquity of the ecliptic
+inline void EclipticSpherical::toEquatorialSpherical(std::span<const DateTime> epochs, std::span<const double> longitude,
+													 std::span<const double> latitude, std::span<double> right_ascension,
+													 std::span<double> declination) {
+	internal::checkCoordinateArraySize(epochs.size(), {longitude.size(), latitude.size(), right_ascension.size(), declination.size()});
+	internal::forEachEclipticFrame(epochs, [&](std::size_t i, const EclipticFrame& frame) {
+		frame.toEquatorialSpherical(longitude[i], latitude[i], right_ascension[i], declination[i]);
+	});
+}
 
-	const double lon = AngleHelper::wrapRadian(std::atan2(
-	  m_data.rightAscension.sin() * std::cos(epsilon) + m_data.declination.tan() * std::sin(epsilon), m_data.rightAscension.cos()));
-	const double lat =
-	  std::asin(m_data.declination.sin() * std::cos(epsilon) - m_data.declination.cos() * std::sin(epsilon) * m_data.rightAscension.sin());
+inline EclipticSpherical EquatorialSpherical::toEclipticSpherical() const {
+	double lon, lat;
+	EclipticFrame(m_epoch).toEclipticSpherical(m_data.rightAscension.radians(), m_data.declination.radians(), lon, lat);
 	return EclipticSpherical(m_epoch, EclipticSphericalPosition{Radian{lon}, Radian{lat}, m_data.distance});
 }
 
+inline void EquatorialSpherical::toEclipticSpherical(std::span<const DateTime> epochs, std::span<const double> right_ascension,
+													 std::span<const double> declination, std::span<double> longitude,
+													 std::span<double> latitude) {
+	internal::checkCoordinateArraySize(epochs.size(), {right_ascension.size(), declination.size(), longitude.size(), latitude.size()});
+	internal::forEachEclipticFrame(epochs, [&](std::size_t i, const EclipticFrame& frame) {
+		frame.toEclipticSpherical(right_ascension[i], declination[i], longitude[i], latitude[i]);
+	});
+}
+
 inline EclipticCartesian EclipticSpherical::toEclipticCartesian() const {
 	return EclipticCartesian(m_epoch, m_data.distance * Eigen::Vector3d{m_data.ecliptic_longitude.cos() * m_data.ecliptic_latitude.cos(),
 																		m_data.ecliptic_longitude.sin() * m_data.ecliptic_latitude.cos(),
@@ -489,14 +924,63 @@ inline EclipticSpherical EclipticCartesian::toEclipticSpherical() const {
 }
 
 inline Eci EclipticCartesian::toEci() const {
-	const double T = (m_epoch.j2000() + m_epoch.deltaT().totalDays()) / constant::jd_century;
-	const double Omega = AngleHelper::degreeToWrapRadian(125.04 - 1934.136 * T); // Longitude of ascending node
-	const double epsilon = AngleHelper::degreeToWrapRadian(23 + (26 + Polynomial::deg3(T, 21.448, 46.8150, 0.00059, -0.001813) / 60) / 60 +
-														   0.00256 * std::cos(Omega)); // Obliquity of the ecliptic
+	return Eci(m_epoch, EclipticFrame(m_epoch).toEci(m_data));
+}
+
+inline void EclipticCartesian::toEci(std::span<const DateTime> epochs, const Eigen::Matrix3Xd& ecliptic, Eigen::Matrix3Xd& eci) {
+	internal::checkCoordinateArraySize(ecliptic.cols(), {epochs.size()});
+	eci.resize(3, ecliptic.cols());
+	internal::forEachEclipticFrame(epochs, [&](std::size_t i, const EclipticFrame& frame) { eci.col(i) = frame.toEci(ecliptic.col(i)); });
+}
+
+inline void Eci::toWgs84(std::span<const EciSample> eci, std::span<Wgs84Sample> wgs84) {
+	internal::checkCoordinateArraySize(eci.size(), {wgs84.size()});
+	internal::FrameRotationCache cache;
+	for (std::size_t i = 0; i < eci.size(); i++) {
+		const Eigen::Vector3d ecef = cache.get(eci[i].epoch()).toEcef(Eigen::Vector3d{eci[i].x, eci[i].y, eci[i].z});
+		wgs84[i].ticks = eci[i].ticks;
+		internal::ecefToWgs84(ecef.x(), ecef.y(), ecef.z(), wgs84[i].longitude, wgs84[i].latitude, wgs84[i].altitude);
+	}
+}
+
+inline void Ecef::toWgs84(std::span<const EcefSample> ecef, std::span<Wgs84Sample> wgs84) {
+	internal::checkCoordinateArraySize(ecef.size(), {wgs84.size()});
+	for (std::size_t i = 0; i < ecef.size(); i++) {
+		wgs84[i].ticks = ecef[i].ticks;
+		internal::ecefToWgs84(ecef[i].x, ecef[i].y, ecef[i].z, wgs84[i].longitude, wgs84[i].latitude, wgs84[i].altitude);
+	}
+}
+
+inline Eci EciSample::toEci() const {
+	return Eci(*this);
+}
+
+inline Ecef EciSample::toEcef() const {
+	return Eci(*this).toEcef();
+}
 
-	const double s_eps = std::sin(epsilon), c_eps = std::cos(epsilon);
+inline Wgs84 EciSample::toWgs84() const {
+	return Eci(*this).toWgs84();
+}
+
+inline Ecef EcefSample::toEcef() const {
+	return Ecef(*this);
+}
+
+inline Eci EcefSample::toEci() const {
+	return Ecef(*this).toEci();
+}
+
+inline Wgs84 EcefSample::toWgs84() const {
+	return Ecef(*this).toWgs84();
+}
+
+inline Wgs84 Wgs84Sample::toWgs84() const {
+	return Wgs84(*this);
+}
 
-	return Eci(m_epoch, Eigen::Vector3d{m_data.x(), m_data.y() * c_eps - m_data.z() * s_eps, m_data.y() * s_eps + m_data.z() * c_eps});
+inline Ecef Wgs84Sample::toEcef() const {
+	return Wgs84(*this).toEcef();
 }
 
 GEOATMOS_NAMESPACE_END
\ No newline at end of file
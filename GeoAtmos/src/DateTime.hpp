@@ -14,8 +14,15 @@
 // clang-format off
 #include <iomanip>
 #include <sstream>
+#include <array>
+#include <bit>
 #include <chrono>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
 
 #include "Essential.hpp"
 #include "AngleHelper.hpp"
@@ -25,6 +32,17 @@
 
 GEOATMOS_NAMESPACE_BEGIN
 
+/**
+ * @brief グレゴリオ暦の日付成分
+ *
+ */
+struct CivilDate {
+	int year;		 // 年
+	int month;		 // 月 [1, 12]
+	int day;		 // 日 [1, 31]
+	int day_of_year; // 年通算日 [1, 366]
+};
+
 class DateTime {
 
   public:
@@ -101,35 +119,87 @@ class DateTime {
 	 */
 	DateTime(std::int64_t ticks) : m_ticks(ticks) {}
 
+	/**
+	 * @brief 解釈できなかった要素に設定するティック数
+	 *
+	 */
+	static constexpr std::int64_t invalid_ticks = std::numeric_limits<std::int64_t>::min();
+
+	/**
+	 * @brief ISO8601 形式文字列を解釈する (例外を送出しない)
+	 * @note 受け付ける形式は DateTime(const std::string&) と同じ
+	 *
+	 * @param date_time ISO8601 形式文字列
+	 * @return std::optional<DateTime> 解釈できない場合は std::nullopt
+	 */
+	static auto parse(std::string_view date_time) noexcept -> std::optional<DateTime> {
+		std::int64_t ticks;
+		int error_code;
+		if (!tryParse(date_time, ticks, error_code)) return std::nullopt;
+		return DateTime(ticks);
+	}
+
+	/**
+	 * @brief ISO8601 形式文字列の配列 (メモリマップしたファイルの列など) をまとめてティック数に変換する
+	 * @note 例外を送出せず, 解釈できない要素には invalid_ticks を設定する
+	 *
+	 * @param date_times ISO8601 形式文字列
+	 * @param ticks ティック数 (date_times と同じ要素数)
+	 * @return std::size_t 解釈できなかった要素数
+	 */
+	static auto parse(std::span<const std::string_view> date_times, std::span<std::int64_t> ticks) -> std::size_t {
+		if (date_times.size() != ticks.size()) {
+			throw DateTimeException("Output buffer size does not match the number of strings.", DateTimeException::InvalidDateTime);
+		}
+
+		std::size_t failures = 0;
+		int error_code;
+		for (std::size_t i = 0; i < date_times.size(); i++) {
+			if (!tryParse(date_times[i], ticks[i], error_code)) {
+				ticks[i] = invalid_ticks;
+				failures++;
+			}
+		}
+		return failures;
+	}
+
+	/**
+	 * @brief 年・月・日・年通算日をまとめて取得する
+	 * @note 複数の成分が必要な場合は year(), month() などを個別に呼ぶより速い
+	 * @return CivilDate 日付成分
+	 */
+	auto civil() const -> CivilDate { return civilFromTicks(m_ticks); }
+
+	/**
+	 * @brief ティック数の配列をまとめて日付成分に分解する
+	 *
+	 * @param ticks ティック数
+	 * @param dates 日付成分 (ticks と同じ要素数)
+	 */
+	static auto civil(std::span<const std::int64_t> ticks, std::span<CivilDate> dates) -> void {
+		if (ticks.size() != dates.size()) {
+			throw DateTimeException("Output buffer size does not match the number of ticks.", DateTimeException::InvalidDateTime);
+		}
+		for (std::size_t i = 0; i < ticks.size(); i++) dates[i] = civilFromTicks(ticks[i]);
+	}
+
 	/**
 	 * @brief 年成分を取得する
 	 * @return int 年成分 [year]
 	 */
-	int year() const {
-		int year, month, day;
-		pushDate(year, month, day);
-		return year;
-	}
+	int year() const { return civil().year; }
 
 	/**
 	 * @brief 月成分を取得する
 	 * @return int 月成分 [month]
 	 */
-	int month() const {
-		int year, month, day;
-		pushDate(year, month, day);
-		return month;
-	}
+	int month() const { return civil().month; }
 
 	/**
 	 * @brief 日成分を取得する
 	 * @return int 日成分 [day]
 	 */
-	int day() const {
-		int year, month, day;
-		pushDate(year, month, day);
-		return day;
-	}
+	int day() const { return civil().day; }
 
 	/**
 	 * @brief 時成分を取得する
@@ -243,47 +313,35 @@ class DateTime {
 	/**
 	 * @brief ΔTを取得する
 	 * @note https://eclipse.gsfc.nasa.gov/SEhelp/deltatpoly2004.html
+	 *       ΔT は年と月だけで決まるため, 1800 年から 2199 年までは月ごとに計算済みの表を引く
 	 * @return auto
 	 */
 	auto deltaT() const -> TimeSpan {
-		const int years = year();
-		double y = (double)years + ((double)month() - 0.5) / 12;
+		const CivilDate date = civil();
+		return deltaTOfMonth(date.year, date.month);
+	}
 
-		if (years < -500) {
-			return TimeSpan(Polynomial::deg2((y - 1820) / 100, -20, 0, 32), TimeUnit::Seconds);
-		} else if (band(years, -500, 500)) {
-			return TimeSpan(Polynomial::deg6(y / 100, 10583.6, -1014.41, 33.78311, -5.952053, -0.1798452, 0.022174192, 0.0090316521),
-							TimeUnit::Seconds);
-		} else if (band(years, 500, 1600)) {
-			return TimeSpan(Polynomial::deg6((y - 1000) / 100, 1574.2, -556.01, 71.23472, 0.319781, -0.8503463, -0.005050998, 0.0083572073),
-							TimeUnit::Seconds);
-		} else if (band(years, 1600, 1700)) {
-			return TimeSpan(Polynomial::deg3(y - 1600, 120, -0.9808, -0.01532, 1.0 / 7129.0), TimeUnit::Seconds);
-		} else if (band(years, 1700, 1800)) {
-			return TimeSpan(Polynomial::deg4(y - 1700, 8.83, 0.1603, -0.0059285, 0.00013336, -1.0 / 1174000.0), TimeUnit::Seconds);
-		} else if (band(years, 1800, 1860)) {
-			return TimeSpan(
-			  Polynomial::deg7(y - 1800, 13.72, -0.332447, 0.0068612, 0.0041116, -0.00037436, 0.0000121272, -0.0000001699, 0.000000000875),
-			  TimeUnit::Seconds);
-		} else if (band(years, 1860, 1900)) {
-			return TimeSpan(Polynomial::deg5(y - 1860, 7.62, 0.5737, -0.251754, 0.01680668, -0.0004473624, 1.0 / 233174.0),
-							TimeUnit::Seconds);
-		} else if (band(years, 1900, 1920)) {
-			return TimeSpan(Polynomial::deg4(y - 1900, -2.79, 1.494119, -0.0598939, 0.0061966, -0.000197), TimeUnit::Seconds);
-		} else if (band(years, 1920, 1941)) {
-			return TimeSpan(Polynomial::deg3(y - 1920, 21.20, 0.84493, -0.076100, 0.0020936), TimeUnit::Seconds);
-		} else if (band(years, 1941, 1961)) {
-			return TimeSpan(Polynomial::deg3(y - 1950, 29.07, 0.407, -1.0 / 233.0, 1.0 / 2547.0), TimeUnit::Seconds);
-		} else if (band(years, 1961, 1986)) {
-			return TimeSpan(Polynomial::deg3(y - 1975, 45.45, 1.067, -1.0 / 260.0, -1.0 / 718.0), TimeUnit::Seconds);
-		} else if (band(years, 1986, 2005)) {
-			return TimeSpan(Polynomial::deg5(y - 2000, 63.86, 0.3345, -0.060374, 0.0017275, 0.000651814, 0.00002373599), TimeUnit::Seconds);
-		} else if (band(years, 2005, 2050)) {
-			return TimeSpan(Polynomial::deg2(y - 2000, 62.92, 0.32217, 0.005589), TimeUnit::Seconds);
-		} else if (band(years, 2050, 2150)) {
-			return TimeSpan(Polynomial::deg2((y - 1820) / 100, -20 - 0.5628 * (2150 - y), 0, 32), TimeUnit::Seconds);
-		} else {
-			return TimeSpan(Polynomial::deg2((y - 1820) / 100, -20, 0, 32), TimeUnit::Seconds);
+	/**
+	 * @brief ティック数の配列の ΔT をまとめて求める
+	 * @note 直前の要素と同じ日であれば日付の分解を省略する
+	 *
+	 * @param ticks ティック数
+	 * @param delta_t ΔT のティック数 (ticks と同じ要素数)
+	 */
+	static auto deltaT(std::span<const std::int64_t> ticks, std::span<std::int64_t> delta_t) -> void {
+		if (ticks.size() != delta_t.size()) {
+			throw DateTimeException("Output buffer size does not match the number of ticks.", DateTimeException::InvalidDateTime);
+		}
+
+		std::int64_t day = 0;
+		for (std::size_t i = 0; i < ticks.size(); i++) {
+			if (i == 0 || ticks[i] / constant::ticks_per_day != day) {
+				const CivilDate date = civilFromTicks(ticks[i]);
+				delta_t[i] = deltaTOfMonth(date.year, date.month).ticks();
+				day = ticks[i] / constant::ticks_per_day;
+			} else {
+				delta_t[i] = delta_t[i - 1];
+			}
 		}
 	}
 
@@ -417,11 +475,7 @@ class DateTime {
 
 	friend auto operator<<(std::ostream& os, const DateTime& dt) -> std::ostream& { return os << dt.toString(); }
 
-	int dayOfYear() const {
-		int year, month, day;
-		pushDate(year, month, day);
-		return dayOfYear(year, month, day);
-	}
+	int dayOfYear() const { return civil().day_of_year; }
 
 	double secondsOfDay() const { return TimeSpan(m_ticks % constant::ticks_per_day).totalSeconds(); }
 
@@ -439,7 +493,7 @@ class DateTime {
 	 * @return true 閏年
 	 * @return false 平年
 	 */
-	auto isLeapYear(int year) const -> bool { return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0; }
+	static auto isLeapYear(int year) -> bool { return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0; }
 
 	/**
 	 * @brief 年の範囲チェック
@@ -448,7 +502,7 @@ class DateTime {
 	 * @return true Pass
 	 * @return false NG
 	 */
-	auto validateYearRange(int year) const -> bool { return year >= 1 && year <= 9999; }
+	static auto validateYearRange(int year) -> bool { return year >= 1 && year <= 9999; }
 
 	/**
 	 * @brief 月の範囲チェック
@@ -457,7 +511,7 @@ class DateTime {
 	 * @return true Pass
 	 * @return false NG
 	 */
-	auto validateMonthRange(int month) const -> bool { return month >= 1 && month <= 12; }
+	static auto validateMonthRange(int month) -> bool { return month >= 1 && month <= 12; }
 
 	/**
 	 * @brief 日付の範囲チェック
@@ -466,7 +520,7 @@ class DateTime {
 	 * @return true Pass
 	 * @return false NG
 	 */
-	auto validateDate(int year, int month, int day) const -> bool {
+	static auto validateDate(int year, int month, int day) -> bool {
 		if (!validateYearRange(year)) {
 			return false;
 		}
@@ -486,7 +540,7 @@ class DateTime {
 	 * @return true Pass
 	 * @return false NG
 	 */
-	auto validateHourRange(int hour) const -> bool { return hour >= 0 && hour <= 23; }
+	static auto validateHourRange(int hour) -> bool { return hour >= 0 && hour <= 23; }
 
 	/**
 	 * @brief 分の範囲チェック
@@ -495,7 +549,7 @@ class DateTime {
 	 * @return true Pass
 	 * @return false NG
 	 */
-	auto validateMinuteRange(int minute) const -> bool { return minute >= 0 && minute <= 59; }
+	static auto validateMinuteRange(int minute) -> bool { return minute >= 0 && minute <= 59; }
 
 	/**
 	 * @brief 秒の範囲チェック
@@ -504,7 +558,7 @@ class DateTime {
 	 * @return true Pass
 	 * @return false NG
 	 */
-	auto validateSecondRange(int second) const -> bool { return second >= 0 && second <= 59; }
+	static auto validateSecondRange(int second) -> bool { return second >= 0 && second <= 59; }
 
 	/**
 	 * @brief マイクロ秒の範囲チェック
@@ -513,7 +567,7 @@ class DateTime {
 	 * @return true Pass
 	 * @return false NG
 	 */
-	auto validateMicrosecondRange(int microsecond) const -> bool { return microsecond >= 0 && microsecond <= 999999; }
+	static auto validateMicrosecondRange(int microsecond) -> bool { return microsecond >= 0 && microsecond <= 999999; }
 
 	/**
 	 * @brief 時間の範囲チェック
@@ -527,7 +581,7 @@ class DateTime {
 	 * @return true Pass
 	 * @return false NG
 	 */
-	auto validateTime(int hour, int minute, int second, int microsecond) const -> bool {
+	static auto validateTime(int hour, int minute, int second, int microsecond) -> bool {
 		if (!validateHourRange(hour)) {
 			return false;
 		}
@@ -543,20 +597,20 @@ class DateTime {
 		return true;
 	}
 
-	auto dayOfYear(int year, int month, int day) const -> int {
+	static auto dayOfYear(int year, int month, int day) -> int {
 		if (!validateDate(year, month, day)) {
 			throw DateTimeException("Date range is invalid", DateTimeException::InvalidDate);
 		}
 		return day + constant::lap_days_in_month[isLeapYear(year)][month];
 	}
 
-	auto absoluteDay(int year, int month, int day) const -> int {
+	static auto absoluteDay(int year, int month, int day) -> int {
 		const int prev_year = year - 1;
 		return dayOfYear(year, month, day) - 1 + prev_year * constant::days_per_nonleap_year + prev_year / 4 - prev_year / 100 +
 			   prev_year / 400;
 	}
 
-	auto absoluteDay(int year, double day_of_year) const -> double {
+	static auto absoluteDay(int year, double day_of_year) -> double {
 		const int prev_year = year - 1;
 		return static_cast<double>(prev_year * constant::days_per_nonleap_year + prev_year / 4 - prev_year / 100 + prev_year / 400) +
 			   day_of_year - 1.0;
@@ -576,137 +630,190 @@ class DateTime {
 	}
 
 	auto initialize(const std::string& date_time) -> void {
-		std::int32_t year, month, day, hour, minute, second, microsecond;
-		year = iso8601BlocktoInt(date_time, 0, 4);
-		month = iso8601BlocktoInt(date_time, 5, 7);
-		day = iso8601BlocktoInt(date_time, 8, 10);
-		if (date_time.length() <= 10) {
-			initialize(year, month, day, 0, 0, 0, 0);
-		} else {
-			hour = iso8601BlocktoInt(date_time, 11, 13);
-			minute = iso8601BlocktoInt(date_time, 14, 16);
-
-			std::string sec_tz = date_time.substr(17);
-
-			// タイムゾーンの位置を探す
-			std::size_t tz_pos = 0;
-			while (tz_pos < sec_tz.length()) {
-				if (sec_tz[tz_pos] == 'Z' || sec_tz[tz_pos] == '+' || sec_tz[tz_pos] == '-') {
-					break;
-				}
-				tz_pos++;
-			}
-
-			iso8601BlocktoDecimal(sec_tz, 0, tz_pos - 1, second, microsecond);
-
-			if (tz_pos == sec_tz.length()) {
-				initialize(year, month, day, hour, minute, second, microsecond);
-			} else {
-				std::string tz = sec_tz.substr(tz_pos);
-				if (tz[0] == 'Z' || tz == "+00:00" || tz == "-00:00" || tz == "UTC" || tz == "GMT") {
-					initialize(year, month, day, hour, minute, second, microsecond);
-				} else {
-					int tz_hour = iso8601BlocktoInt(tz, 1, 3);
-					int tz_minute = iso8601BlocktoInt(tz, 4, 6);
-					initialize(year, month, day, hour, minute, second, microsecond);
-					if (tz[0] == '-') {
-						m_ticks += TimeSpan(tz_hour, tz_minute, 0).ticks();
-					} else {
-						m_ticks -= TimeSpan(tz_hour, tz_minute, 0).ticks();
-					}
-				}
+		int error_code;
+		if (!tryParse(date_time, m_ticks, error_code)) {
+			switch (error_code) {
+				case DateTimeException::InvalidDate: throw DateTimeException("Date range is invalid", error_code);
+				case DateTimeException::InvalidTime: throw DateTimeException("Time range is invalid", error_code);
+				default: throw DateTimeException("Invalid ISO8601 format", error_code);
 			}
 		}
 	}
 
-	auto iso8601BlocktoInt(const std::string& str, int begin, int end) const -> int {
-		int value = 0;
-		for (int i = begin; i < end; i++) {
-			if (str[i] < '0' || str[i] > '9') {
-				throw DateTimeException("Invalid integer string", DateTimeException::InvalidIso8601Format);
-			}
-			value = value * 10 + (str[i] - '0');
-		}
-		return value;
+	/**
+	 * @brief 8 バイトのうち mask の位置がすべて数字であるかをまとめて検査する
+	 * @note mask の位置以外は '0' に置き換えてから, 各バイトが 0x30-0x39 にあることを 64 bit 整数の演算で確認する
+	 */
+	static auto iso8601Digits(const char* p, std::uint64_t mask) noexcept -> bool {
+		constexpr std::uint64_t zeros = 0x3030303030303030ULL;
+		constexpr std::uint64_t high = 0xF0F0F0F0F0F0F0F0ULL;
+		std::uint64_t word;
+		std::memcpy(&word, p, sizeof(word));
+		word = (word & mask) | (zeros & ~mask);
+		return ((word & high) == zeros) && (((word + 0x0606060606060606ULL) & high) == zeros);
 	}
 
-	auto iso8601BlocktoDecimal(const std::string& str, int begin, int end, int& integer, int& decimal) const -> double {
-		double ret = 0;
-		std::int32_t div = 1;
-		std::int32_t decimal_point_pos = begin;
+	/**
+	 * @brief ISO8601 形式文字列を解釈する (例外を送出しない)
+	 * @note 日付・時刻の固定位置の数字は iso8601Digits でまとめて検査する. 区切り文字は検査しない
+	 *
+	 * @param str ISO8601 形式文字列
+	 * @param ticks 解釈したティック数
+	 * @param error_code 失敗した場合の DateTimeException のエラーコード
+	 * @return true 成功
+	 */
+	static auto tryParse(std::string_view str, std::int64_t& ticks, int& error_code) noexcept -> bool {
+		// "YYYY-MM-" と "DD-DD-DD" ("MM-DD" および "DDThh:mm") の数字の位置
+		constexpr auto date_mask = std::bit_cast<std::uint64_t>(std::array<unsigned char, 8>{0xFF, 0xFF, 0xFF, 0xFF, 0, 0xFF, 0xFF, 0});
+		constexpr auto pair_mask = std::bit_cast<std::uint64_t>(std::array<unsigned char, 8>{0xFF, 0xFF, 0, 0xFF, 0xFF, 0, 0xFF, 0xFF});
+		const auto digit = [](char c) { return c >= '0' && c <= '9'; };
+		const auto two = [](const char* p) { return (p[0] - '0') * 10 + (p[1] - '0'); };
+
+		const char* p = str.data();
+		const std::size_t n = str.size();
+		error_code = DateTimeException::InvalidIso8601Format;
+		if (n < 10 || (n > 10 && n < 16)) return false;
+		if (!iso8601Digits(p, date_mask) || !iso8601Digits(p + 2, pair_mask)) return false;
+		if (n >= 16 && !iso8601Digits(p + 8, pair_mask)) return false;
+
+		const int year = two(p) * 100 + two(p + 2);
+		const int month = two(p + 5);
+		const int day = two(p + 8);
+		int hour = 0, minute = 0, second = 0, microsecond = 0;
+		std::int64_t offset = 0;
+		if (n > 10) {
+			hour = two(p + 11);
+			minute = two(p + 14);
+
+			// 秒 (小数部は 6 桁目まで)
+			std::size_t i = 17;
+			for (; i < n && digit(p[i]); i++) {
+				if (i >= 19) return false;
+				second = second * 10 + (p[i] - '0');
+			}
+			if (i < n && p[i] == '.') {
+				for (int scale = 100000; ++i < n && digit(p[i]); scale /= 10) microsecond += (p[i] - '0') * scale;
+			}
 
-		while (decimal_point_pos <= end) {
-			if (str[decimal_point_pos] == '.') {
-				break;
+			// タイムゾーン
+			if (i < n && p[i] != 'Z') {
+				const bool sign = (p[i] == '+' || p[i] == '-');
+				if (!sign || n - i != 6 || !digit(p[i + 1]) || !digit(p[i + 2]) || !digit(p[i + 4]) || !digit(p[i + 5])) return false;
+				offset = TimeSpan(two(p + i + 1), two(p + i + 4), 0).ticks();
+				if (p[i] == '+') offset = -offset;
 			}
-			decimal_point_pos++;
 		}
 
-		integer = iso8601BlocktoInt(str, begin, decimal_point_pos);
-		decimal = 0;
-
-		if (decimal_point_pos < end) {
-			decimal = iso8601BlocktoInt(str, decimal_point_pos + 1, end + 1);
-			for (int i = decimal_point_pos + 1; i <= end; i++) {
-				div *= 10;
-			}
+		if (!validateDate(year, month, day)) {
+			error_code = DateTimeException::InvalidDate;
+			return false;
+		}
+		if (!validateTime(hour, minute, second, microsecond)) {
+			error_code = DateTimeException::InvalidTime;
+			return false;
 		}
+		ticks = TimeSpan(absoluteDay(year, month, day), hour, minute, second, microsecond).ticks() + offset;
+		return true;
+	}
 
-		ret = static_cast<double>(integer) + static_cast<double>(decimal) / static_cast<double>(div);
+	auto pushDate(int& year, int& month, int& day) const -> void {
+		const CivilDate date = civil();
+		year = date.year;
+		month = date.month;
+		day = date.day;
+	}
+
+	/**
+	 * @brief ティック数を日付成分に分解する
+	 * @note 3月始まりの年で400年周期を分解する方法 (H. Hinnant, chrono-Compatible Low-Level Date Algorithms).
+	 *       年・月のループや分岐を含まない
+	 */
+	static auto civilFromTicks(std::int64_t ticks) -> CivilDate {
+		// 0000-03-01 からの通算日 (0001-01-01 は 306 日目)
+		const int days = static_cast<int>(ticks / constant::ticks_per_day) + 306;
+		const int era = days / 146097;
+		const int day_of_era = days - era * 146097;
+		const int year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+		const int day_of_march_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+		const int mp = (5 * day_of_march_year + 2) / 153; // 3月を 0 とした月
 
-		decimal = decimal * (1000'000 / div);
+		CivilDate date;
+		date.month = (mp < 10) ? mp + 3 : mp - 9;
+		date.year = era * 400 + year_of_era + (mp >= 10);
+		date.day = day_of_march_year - (153 * mp + 2) / 5 + 1;
 
-		return ret;
+		const bool leap = (date.year % 4 == 0 && date.year % 100 != 0) || date.year % 400 == 0;
+		date.day_of_year = (mp >= 10) ? day_of_march_year - 305 : day_of_march_year + 60 + leap;
+		return date;
 	}
 
-	auto pushDate(int& year, int& month, int& day) const -> void {
-		int total_days = static_cast<int>(m_ticks / constant::ticks_per_day);
-
-		// 年
-		{
-			// 4世紀単位の数
-			int num_4cent = total_days / 146097;
-			total_days -= num_4cent * 146097;
-
-			// 1世紀単位の数
-			int num_1cent = total_days / 36524;
-			if (num_1cent == 4) {
-				// 閏世紀末日
-				num_1cent = 3;
-			}
-			total_days -= num_1cent * 36524;
-
-			// 4年単位の数
-			int num_4year = total_days / 1461;
-			total_days -= num_4year * 1461;
-
-			// 1年単位の数
-			int num_year = total_days / 365;
-			if (num_year == 4) {
-				/*
-				 * 閏年末日
-				 */
-				num_year = 3;
-			}
-			total_days -= num_year * 365;
+	static auto band(const double x, const double l, const double r) -> bool { return x >= l && x < r; }
 
-			year = (num_4cent * 400) + (num_1cent * 100) + (num_4year * 4) + num_year + 1;
-		}
+	static constexpr int delta_t_table_first_year = 1800; // ΔT の表の最初の年
+	static constexpr int delta_t_table_last_year = 2199;  // ΔT の表の最後の年
 
-		// 月
-		{
-			const auto& dyas_in_mounth = constant::dyas_in_mounth[isLeapYear(year)];
-			month = 1;
-			while (total_days >= dyas_in_mounth[month] && month <= 12) {
-				total_days -= dyas_in_mounth[month++];
-			}
-		}
+	/**
+	 * @brief 年・月の ΔT を取得する (表の範囲外は多項式で計算する)
+	 *
+	 */
+	static auto deltaTOfMonth(int year, int month) -> TimeSpan {
+		if (year < delta_t_table_first_year || year > delta_t_table_last_year) return deltaTPolynomial(year, month);
 
-		// 日
-		day = total_days + 1;
+		// 最初の呼び出しで作成する (スレッド安全)
+		static const auto table = [] {
+			std::array<std::int64_t, (delta_t_table_last_year - delta_t_table_first_year + 1) * 12> t;
+			for (std::size_t i = 0; i < t.size(); i++) {
+				t[i] = deltaTPolynomial(delta_t_table_first_year + static_cast<int>(i / 12), static_cast<int>(i % 12) + 1).ticks();
+			}
+			return t;
+		}();
+		return TimeSpan(table[(year - delta_t_table_first_year) * 12 + (month - 1)]);
 	}
 
-	auto band(const double x, const double l, const double r) const -> bool { return x >= l && x < r; }
+	/**
+	 * @brief 年・月の ΔT を多項式で計算する
+	 *
+	 */
+	static auto deltaTPolynomial(int years, int month) -> TimeSpan {
+		double y = (double)years + ((double)month - 0.5) / 12;
+
+		if (years < -500) {
+			return TimeSpan(Polynomial::deg2((y - 1820) / 100, -20, 0, 32), TimeUnit::Seconds);
+		} else if (band(years, -500, 500)) {
+			return TimeSpan(Polynomial::deg6(y / 100, 10583.6, -1014.41, 33.78311, -5.952053, -0.1798452, 0.022174192, 0.0090316521),
+							TimeUnit::Seconds);
+		} else if (band(years, 500, 1600)) {
+			return TimeSpan(Polynomial::deg6((y - 1000) / 100, 1574.2, -556.01, 71.23472, 0.319781, -0.8503463, -0.005050998, 0.0083572073),
+							TimeUnit::Seconds);
+		} else if (band(years, 1600, 1700)) {
+			return TimeSpan(Polynomial::deg3(y - 1600, 120, -0.9808, -0.01532, 1.0 / 7129.0), TimeUnit::Seconds);
+		} else if (band(years, 1700, 1800)) {
+			return TimeSpan(Polynomial::deg4(y - 1700, 8.83, 0.1603, -0.0059285, 0.00013336, -1.0 / 1174000.0), TimeUnit::Seconds);
+		} else if (band(years, 1800, 1860)) {
+			return TimeSpan(
+			  Polynomial::deg7(y - 1800, 13.72, -0.332447, 0.0068612, 0.0041116, -0.00037436, 0.0000121272, -0.0000001699, 0.000000000875),
+			  TimeUnit::Seconds);
+		} else if (band(years, 1860, 1900)) {
+			return TimeSpan(Polynomial::deg5(y - 1860, 7.62, 0.5737, -0.251754, 0.01680668, -0.0004473624, 1.0 / 233174.0),
+							TimeUnit::Seconds);
+		} else if (band(years, 1900, 1920)) {
+			return TimeSpan(Polynomial::deg4(y - 1900, -2.79, 1.494119, -0.0598939, 0.0061966, -0.000197), TimeUnit::Seconds);
+		} else if (band(years, 1920, 1941)) {
+			return TimeSpan(Polynomial::deg3(y - 1920, 21.20, 0.84493, -0.076100, 0.0020936), TimeUnit::Seconds);
+		} else if (band(years, 1941, 1961)) {
+			return TimeSpan(Polynomial::deg3(y - 1950, 29.07, 0.407, -1.0 / 233.0, 1.0 / 2547.0), TimeUnit::Seconds);
+		} else if (band(years, 1961, 1986)) {
+			return TimeSpan(Polynomial::deg3(y - 1975, 45.45, 1.067, -1.0 / 260.0, -1.0 / 718.0), TimeUnit::Seconds);
+		} else if (band(years, 1986, 2005)) {
+			return TimeSpan(Polynomial::deg5(y - 2000, 63.86, 0.3345, -0.060374, 0.0017275, 0.000651814, 0.00002373599), TimeUnit::Seconds);
+		} else if (band(years, 2005, 2050)) {
+			return TimeSpan(Polynomial::deg2(y - 2000, 62.92, 0.32217, 0.005589), TimeUnit::Seconds);
+		} else if (band(years, 2050, 2150)) {
+			return TimeSpan(Polynomial::deg2((y - 1820) / 100, -20 - 0.5628 * (2150 - y), 0, 32), TimeUnit::Seconds);
+		} else {
+			return TimeSpan(Polynomial::deg2((y - 1820) / 100, -20, 0, 32), TimeUnit::Seconds);
+		}
+	}
 
 	friend auto operator+(const DateTime& dt, TimeSpan ts) -> DateTime { return DateTime(dt.ticks() + ts.ticks()); }
 
@@ -0,0 +1,190 @@
+/**
+ * @file DensityGrid.hpp
+ * @author fugu133
+ * @brief 格子点上の大気パラメータの並列計算
+ * @version 0.1
+ * @date 2024-01-06
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "Coordinate.hpp"
+#include "Essential.hpp"
+#include "GeoAtmosDensity.hpp"
+#include "SpaceWeather.hpp"
+
+GEOATMOS_NAMESPACE_BEGIN
+
+/**
+ * @brief 時刻 × 緯度 × 経度 × 高度 の計算格子
+ * @note 出力は高度が最も速く変化する順 (時刻, 緯度, 経度, 高度) に並ぶ
+ *
+ */
+struct DensityGrid {
+	std::vector<DateTime> epochs;  // 時刻
+	std::vector<Angle> latitudes;  // 緯度
+	std::vector<Angle> longitudes; // 経度
+	std::vector<double> altitudes; // 高度 [m]
+
+	std::size_t size() const { return epochs.size() * latitudes.size() * longitudes.size() * altitudes.size(); }
+
+	/**
+	 * @brief 格子点の出力配列上の位置
+	 *
+	 */
+	std::size_t index(std::size_t t, std::size_t lat, std::size_t lon, std::size_t alt) const {
+		return ((t * latitudes.size() + lat) * longitudes.size() + lon) * altitudes.size() + alt;
+	}
+
+	/**
+	 * @brief 出力配列上の位置に対応する格子点
+	 *
+	 */
+	Wgs84 at(std::size_t i) const {
+		const std::size_t alt = i % altitudes.size();
+		i /= altitudes.size();
+		const std::size_t lon = i % longitudes.size();
+		i /= longitudes.size();
+		const std::size_t lat = i % latitudes.size();
+		const std::size_t t = i / latitudes.size();
+		return Wgs84{epochs[t], longitudes[lon], latitudes[lat], altitudes[alt]};
+	}
+};
+
+/**
+ * @brief 計算格子の大気パラメータを複数スレッドで計算する
+ * @note 格子はチャンクに分割され, 空いたスレッドが順に次のチャンクを取得する.
+ *       出力の並びはスレッド数やチャンクサイズに依存しない
+ *
+ */
+class DensityGridEvaluator {
+  public:
+	/**
+	 * @param model 大気モデル (出力単位の設定を含めて複製される)
+	 * @param num_threads スレッド数 (0 の場合はハードウェアの同時実行数)
+	 * @param chunk_size 1回に取得する格子点数 (0 の場合は自動)
+	 */
+	DensityGridEvaluator(const GeoAtmosDensity &model, std::size_t num_threads = 0, std::size_t chunk_size = 0)
+	  : m_model(model), m_num_threads(num_threads), m_chunk_size(chunk_size) {
+		if (m_num_threads == 0) m_num_threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	std::size_t numThreads() const { return m_num_threads; }
+	std::size_t chunkSize() const { return m_chunk_size; }
+
+	/**
+	 * @brief 計算格子の大気パラメータを計算する
+	 *
+	 * @param grid 計算格子
+	 * @param db 宇宙天気データベース
+	 * @param output 出力先 (grid.size() と同じ要素数)
+	 */
+	void evaluate(const DensityGrid &grid, const SpaceWeather &db, std::span<AtmosphericParameters> output) const {
+		run(grid, output, [&](std::span<const Wgs84> positions, std::span<AtmosphericParameters> out) {
+			m_model.batch(positions, db, out);
+		});
+	}
+
+	/**
+	 * @brief 計算格子の大気パラメータを計算する
+	 *
+	 * @param grid 計算格子
+	 * @param f107_average F10.7 の81日中心平均値
+	 * @param f107_daily 前日の F10.7
+	 * @param ap 磁気指数
+	 * @param output 出力先 (grid.size() と同じ要素数)
+	 */
+	void evaluate(const DensityGrid &grid, double f107_average, double f107_daily, const MagneticIndex &ap,
+				  std::span<AtmosphericParameters> output) const {
+		run(grid, output, [&](std::span<const Wgs84> positions, std::span<AtmosphericParameters> out) {
+			m_model.batch(positions, f107_average, f107_daily, ap, out);
+		});
+	}
+
+	/**
+	 * @brief 計算格子の大気パラメータを計算する
+	 *
+	 * @param grid 計算格子
+	 * @param db 宇宙天気データベース
+	 * @return std::vector<AtmosphericParameters> 各格子点の大気パラメータ (DensityGrid::index() の順)
+	 */
+	std::vector<AtmosphericParameters> evaluate(const DensityGrid &grid, const SpaceWeather &db) const {
+		std::vector<AtmosphericParameters> output(grid.size());
+		evaluate(grid, db, std::span{output});
+		return output;
+	}
+
+  private:
+	GeoAtmosDensity m_model;
+	std::size_t m_num_threads;
+	std::size_t m_chunk_size;
+
+	template <class Kernel>
+	void run(const DensityGrid &grid, std::span<AtmosphericParameters> output, const Kernel &kernel) const;
+};
+
+template <class Kernel>
+void DensityGridEvaluator::run(const DensityGrid &grid, std::span<AtmosphericParameters> output, const Kernel &kernel) const {
+	const std::size_t total = grid.size();
+	if (output.size() != total) {
+		throw AtmosModelException("Output buffer size does not match the grid size.", AtmosModelException::InvalidValue);
+	}
+	if (total == 0) return;
+
+	// スレッドあたり複数チャンクを割り当てて負荷の偏りを均す
+	constexpr std::size_t chunks_per_thread = 16;
+	const std::size_t auto_chunk_size = (total + m_num_threads * chunks_per_thread - 1) / (m_num_threads * chunks_per_thread);
+	const std::size_t chunk_size = (m_chunk_size != 0) ? m_chunk_size : std::max<std::size_t>(1, auto_chunk_size);
+	const std::size_t num_chunks = (total + chunk_size - 1) / chunk_size;
+	const std::size_t num_threads = std::min(m_num_threads, num_chunks);
+
+	std::atomic<std::size_t> next_chunk{0};
+	std::atomic<bool> failed{false};
+	std::exception_ptr error;
+	std::mutex error_mutex;
+
+	auto worker = [&]() {
+		std::vector<Wgs84> positions;
+		positions.reserve(chunk_size);
+
+		try {
+			for (std::size_t c = next_chunk++; c < num_chunks && !failed; c = next_chunk++) {
+				const std::size_t begin = c * chunk_size;
+				const std::size_t end = std::min(begin + chunk_size, total);
+
+				positions.clear();
+				for (std::size_t i = begin; i < end; i++) positions.push_back(grid.at(i));
+				kernel(std::span<const Wgs84>{positions}, output.subspan(begin, end - begin));
+			}
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(error_mutex);
+			if (!error) error = std::current_exception();
+			failed = true;
+		}
+	};
+
+	if (num_threads <= 1) {
+		worker();
+	} else {
+		std::vector<std::thread> threads;
+		threads.reserve(num_threads - 1);
+		for (std::size_t i = 1; i < num_threads; i++) threads.emplace_back(worker);
+		worker();
+		for (auto &th : threads) th.join();
+	}
+
+	if (error) std::rethrow_exception(error);
+}
+
+GEOATMOS_NAMESPACE_END
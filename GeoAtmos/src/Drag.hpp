@@ -0,0 +1,238 @@
+/**
+ * @file Drag.hpp
+ * @author fugu133
+ * @brief 大気抵抗による加速度の計算
+ * @version 0.1
+ * @date 2024-01-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+#include "Coordinate.hpp"
+#include "Essential.hpp"
+#include "GeoAtmosDensity.hpp"
+#include "SpaceWeather.hpp"
+
+GEOATMOS_NAMESPACE_BEGIN
+
+/**
+ * @brief 抗力加速度の偏微分 (ECI)
+ *
+ */
+struct DragPartials {
+	Eigen::Matrix3d position; // ∂a/∂r [1/s^2]
+	Eigen::Matrix3d velocity; // ∂a/∂v [1/s]
+};
+
+/**
+ * @brief 地球とともに回転する大気による抗力加速度 a = -1/2 ρ B |v_rel| v_rel (v_rel = v - ω × r) を計算する
+ * @note 弾道係数 B は Cd A / m [m^2/kg]. 大気密度は GeoAtmosDensity::batch でまとめて計算し,
+ *       一括計算では地球自転の回転と宇宙天気データの参照を状態間で使い回す.
+ *       ∂a/∂r の密度勾配は GeoAtmosDensity::gradient による高度・緯度・経度の偏微分から求める
+ *
+ */
+class DragModel {
+  public:
+	/**
+	 * @param model 大気モデル (複製され, 密度の出力単位は kg/m^3 に設定される)
+	 */
+	explicit DragModel(const GeoAtmosDensity &model = GeoAtmosDensity{}) : m_model(model) {
+		m_model.configureOutputUnit(DensityUnit::KgPerM3, TemperatureUnit::Kelvin);
+	}
+
+	/**
+	 * @brief 抗力加速度を計算する
+	 *
+	 * @param position 位置 (ECI) [m]
+	 * @param velocity 速度 (ECI) [m/s]
+	 * @param ballistic_coefficient 弾道係数 Cd A / m [m^2/kg]
+	 * @param db 宇宙天気データベース
+	 * @return Eigen::Vector3d 抗力加速度 (ECI) [m/s^2]
+	 */
+	Eigen::Vector3d acceleration(const Eci &position, const Eigen::Vector3d &velocity, double ballistic_coefficient,
+								 const SpaceWeather &db) const {
+		const FrameRotation rotation(position.epoch());
+		const Wgs84Sample s = geodetic(rotation, position.epoch(), position());
+		const double rho = m_model(s, db).density.atmosphere;
+
+		Eigen::Vector3d a;
+		dragTerms(position(), velocity, ballistic_coefficient, rho, Eigen::Vector3d::Zero(), a, nullptr);
+		return a;
+	}
+
+	/**
+	 * @brief 抗力加速度とその偏微分を計算する
+	 *
+	 * @param position 位置 (ECI) [m]
+	 * @param velocity 速度 (ECI) [m/s]
+	 * @param ballistic_coefficient 弾道係数 Cd A / m [m^2/kg]
+	 * @param db 宇宙天気データベース
+	 * @param partials 偏微分の出力先
+	 * @return Eigen::Vector3d 抗力加速度 (ECI) [m/s^2]
+	 */
+	Eigen::Vector3d acceleration(const Eci &position, const Eigen::Vector3d &velocity, double ballistic_coefficient, const SpaceWeather &db,
+								 DragPartials &partials) const {
+		const FrameRotation rotation(position.epoch());
+		const Wgs84Sample s = geodetic(rotation, position.epoch(), position());
+		const DensityGradient g = m_model.gradient(s, db);
+
+		Eigen::Vector3d a;
+		dragTerms(position(), velocity, ballistic_coefficient, g.density, densityGradient(rotation, s, g), a, &partials);
+		return a;
+	}
+
+	/**
+	 * @brief 複数の状態の抗力加速度を一括で計算する
+	 * @note acceleration は必要に応じて 3 x n に確保し直される
+	 *
+	 * @param epochs 各状態の時刻
+	 * @param position 位置の配列 (各列が1点, ECI) [m]
+	 * @param velocity 速度の配列 (各列が1点, ECI) [m/s]
+	 * @param ballistic_coefficient 弾道係数 Cd A / m [m^2/kg]
+	 * @param db 宇宙天気データベース
+	 * @param acceleration 抗力加速度の出力先 (各列が1点, ECI) [m/s^2]
+	 */
+	void acceleration(std::span<const DateTime> epochs, const Eigen::Matrix3Xd &position, const Eigen::Matrix3Xd &velocity,
+					  double ballistic_coefficient, const SpaceWeather &db, Eigen::Matrix3Xd &acceleration) const {
+		internal::checkCoordinateArraySize(position.cols(), {epochs.size(), static_cast<std::size_t>(velocity.cols())});
+		acceleration.resize(3, position.cols());
+		evaluate(epochs, position, velocity, ballistic_coefficient, db, acceleration, nullptr);
+	}
+
+	/**
+	 * @brief 複数の状態の抗力加速度とその偏微分を一括で計算する
+	 * @note acceleration は必要に応じて 3 x n に確保し直される
+	 *
+	 * @param epochs 各状態の時刻
+	 * @param position 位置の配列 (各列が1点, ECI) [m]
+	 * @param velocity 速度の配列 (各列が1点, ECI) [m/s]
+	 * @param ballistic_coefficient 弾道係数 Cd A / m [m^2/kg]
+	 * @param db 宇宙天気データベース
+	 * @param acceleration 抗力加速度の出力先 (各列が1点, ECI) [m/s^2]
+	 * @param partials 偏微分の出力先 (epochs と同じ要素数)
+	 */
+	void acceleration(std::span<const DateTime> epochs, const Eigen::Matrix3Xd &position, const Eigen::Matrix3Xd &velocity,
+					  double ballistic_coefficient, const SpaceWeather &db, Eigen::Matrix3Xd &acceleration,
+					  std::span<DragPartials> partials) const {
+		internal::checkCoordinateArraySize(position.cols(), {epochs.size(), static_cast<std::size_t>(velocity.cols()), partials.size()});
+		acceleration.resize(3, position.cols());
+		evaluate(epochs, position, velocity, ballistic_coefficient, db, acceleration, partials.data());
+	}
+
+  private:
+	static constexpr std::size_t chunk_size = 64; // 大気密度をまとめて計算する状態数
+
+	GeoAtmosDensity m_model;
+
+	void evaluate(std::span<const DateTime> epochs, const Eigen::Matrix3Xd &position, const Eigen::Matrix3Xd &velocity,
+				  double ballistic_coefficient, const SpaceWeather &db, Eigen::Matrix3Xd &acceleration, DragPartials *partials) const;
+
+	/**
+	 * @brief ECI 位置を WGS84 測地座標に変換する
+	 *
+	 */
+	static Wgs84Sample geodetic(const FrameRotation &rotation, const DateTime &epoch, const Eigen::Vector3d &position) {
+		const Eigen::Vector3d ecef = rotation.toEcef(position);
+		Wgs84Sample s{epoch.ticks(), 0, 0, 0};
+		internal::ecefToWgs84(ecef.x(), ecef.y(), ecef.z(), s.longitude, s.latitude, s.altitude);
+		return s;
+	}
+
+	/**
+	 * @brief 大気密度の勾配 ∇ρ (ECI) [kg/m^4]
+	 * @note ∇h は楕円体の法線, ∇φ は北向きの単位ベクトル / (M + h), ∇λ は東向きの単位ベクトル / ((N + h) cos φ)
+	 *       (M, N は子午線・卯酉線曲率半径)
+	 *
+	 */
+	static Eigen::Vector3d densityGradient(const FrameRotation &rotation, const Wgs84Sample &s, const DensityGradient &g) {
+		constexpr double a = constant::wgs84_a;
+		constexpr double e2 = 1.0 - (constant::wgs84_b * constant::wgs84_b) / (a * a);
+		const double sin_lat = std::sin(s.latitude), cos_lat = std::cos(s.latitude);
+		const double sin_lon = std::sin(s.longitude), cos_lon = std::cos(s.longitude);
+		const double w = 1.0 - e2 * sin_lat * sin_lat;
+		const double n = a / std::sqrt(w), m = n * (1.0 - e2) / w;
+
+		const Eigen::Vector3d up{cos_lat * cos_lon, cos_lat * sin_lon, sin_lat};
+		const Eigen::Vector3d north{-sin_lat * cos_lon, -sin_lat * sin_lon, cos_lat};
+		const Eigen::Vector3d east{-sin_lon, cos_lon, 0};
+		return rotation.toEci(g.altitude * up + (g.latitude / (m + s.altitude)) * north +
+							  (g.longitude / ((n + s.altitude) * cos_lat)) * east);
+	}
+
+	static void dragTerms(const Eigen::Vector3d &r, const Eigen::Vector3d &v, double ballistic_coefficient, double rho,
+						  const Eigen::Vector3d &grad_rho, Eigen::Vector3d &acceleration, DragPartials *partials);
+};
+
+/**
+ * @brief 大気密度とその勾配から抗力加速度と偏微分を求める
+ *
+ * @param grad_rho 大気密度の勾配 (ECI) [kg/m^4]
+ * @param partials 偏微分の出力先 (nullptr の場合は計算しない)
+ */
+inline void DragModel::dragTerms(const Eigen::Vector3d &r, const Eigen::Vector3d &v, double ballistic_coefficient, double rho,
+								 const Eigen::Vector3d &grad_rho, Eigen::Vector3d &acceleration, DragPartials *partials) {
+	constexpr double w = constant::earth_rotation_rate;
+	const double coefficient = -0.5 * ballistic_coefficient;
+	const Eigen::Vector3d v_rel{v.x() + w * r.y(), v.y() - w * r.x(), v.z()};
+	const double speed = v_rel.norm();
+	acceleration = coefficient * rho * speed * v_rel;
+	if (!partials) return;
+
+	// ∂a/∂v = -1/2 ρ B (|v_rel| I + v_rel v_rel^T / |v_rel|)
+	partials->velocity = coefficient * rho * speed * Eigen::Matrix3d::Identity();
+	if (speed > 0) partials->velocity += (coefficient * rho / speed) * v_rel * v_rel.transpose();
+
+	// ∂a/∂r = -1/2 B |v_rel| v_rel ∇ρ^T + ∂a/∂v ∂v_rel/∂r (∂v_rel/∂r = -[ω×])
+	Eigen::Matrix3d minus_omega_cross;
+	minus_omega_cross << 0, w, 0, -w, 0, 0, 0, 0, 0;
+	partials->position = (coefficient * speed) * v_rel * grad_rho.transpose() + partials->velocity * minus_omega_cross;
+}
+
+/**
+ * @brief 状態を chunk_size ごとに WGS84 測地座標に変換し, 大気密度をまとめて計算して抗力加速度を求める
+ * @note 偏微分を求める場合は密度と勾配を GeoAtmosDensity::gradient で状態ごとに計算する
+ *
+ * @param partials 偏微分の出力先 (nullptr の場合は計算しない)
+ */
+inline void DragModel::evaluate(std::span<const DateTime> epochs, const Eigen::Matrix3Xd &position, const Eigen::Matrix3Xd &velocity,
+								double ballistic_coefficient, const SpaceWeather &db, Eigen::Matrix3Xd &acceleration,
+								DragPartials *partials) const {
+	internal::FrameRotationCache cache;
+	if (partials) {
+		for (std::size_t i = 0; i < epochs.size(); i++) {
+			const FrameRotation rotation = cache.get(epochs[i]);
+			const Wgs84Sample s = geodetic(rotation, epochs[i], position.col(i));
+			const DensityGradient g = m_model.gradient(s, db);
+			Eigen::Vector3d a;
+			dragTerms(position.col(i), velocity.col(i), ballistic_coefficient, g.density, densityGradient(rotation, s, g), a,
+					  &partials[i]);
+			acceleration.col(i) = a;
+		}
+		return;
+	}
+
+	Wgs84Sample samples[chunk_size];
+	AtmosphericParameters params[chunk_size];
+	for (std::size_t i = 0; i < epochs.size(); i += chunk_size) {
+		const std::size_t n = std::min(chunk_size, epochs.size() - i);
+		for (std::size_t k = 0; k < n; k++) samples[k] = geodetic(cache.get(epochs[i + k]), epochs[i + k], position.col(i + k));
+
+		m_model.batch(std::span<const Wgs84Sample>{samples, n}, db, std::span{params, n});
+
+		for (std::size_t k = 0; k < n; k++) {
+			Eigen::Vector3d a;
+			dragTerms(position.col(i + k), velocity.col(i + k), ballistic_coefficient, params[k].density.atmosphere,
+					  Eigen::Vector3d::Zero(), a, nullptr);
+			acceleration.col(i + k) = a;
+		}
+	}
+}
+
+GEOATMOS_NAMESPACE_END
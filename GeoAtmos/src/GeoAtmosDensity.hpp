@@ -11,7 +11,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
 
 #include "Coordinate.hpp"
 #include "Essential.hpp"
@@ -37,44 +41,289 @@ namespace internal {
 } // namespace internal
 /**
  * @brief 地球大気モデル
+ * @note 計算は const で内部状態を変更しないため, 1つのインスタンスを複数スレッドから同時に使用できる
+ *       (configureOutputUnit() による設定変更を除く)
+ *       Config に ModelConfig を与えるとスイッチがコンパイル時定数になり, 無効な項の計算は最適化で取り除かれる.
+ *       この場合は出力単位も Config で決まり, 実行時には変更できない.
+ *       GlobeScalar を float にすると一括計算の球面調和展開を単精度で2倍のレーン数で計算する.
+ *       高度方向の積分 (densu / densm) は倍精度のままで, 結果は倍精度の計算と相対誤差 1e-5 以内で一致する
  *
+ * @tparam Config モデル設定 (RuntimeModelConfig の場合は実行時に設定する)
+ * @tparam GlobeScalar 一括計算で球面調和展開に使う浮動小数点型 (double または float)
  */
-class GeoAtmosDensity : private internal::Nrlmsise {
+template <auto Config = RuntimeModelConfig{}, class GlobeScalar = double>
+class GeoAtmosDensityT : private internal::Nrlmsise {
+	static constexpr bool is_static_config = std::is_same_v<std::remove_cv_t<decltype(Config)>, ModelConfig>;
+	static_assert(is_static_config || std::is_same_v<std::remove_cv_t<decltype(Config)>, RuntimeModelConfig>,
+				  "Config must be a ModelConfig or RuntimeModelConfig.");
+	static_assert(std::is_same_v<GlobeScalar, double> || std::is_same_v<GlobeScalar, float>, "GlobeScalar must be double or float.");
+
   public:
-	GeoAtmosDensity() : m_config(), m_nv_input(), m_nv_output(), m_nv_config(), temperature_offset(0) {}
+	GeoAtmosDensityT() : m_config(), temperature_offset(0) {
+		if constexpr (is_static_config) {
+			m_config = Config;
+			if (m_config.degc_unit_conversion == SwitchStatus::On) temperature_offset = constant::temperature_0degc_in_kelvin;
+		}
+	}
 
-	GeoAtmosDensity(DensityUnit d_unit, TemperatureUnit t_unit) : GeoAtmosDensity() { configureOutputUnit(d_unit, t_unit); }
+	GeoAtmosDensityT(DensityUnit d_unit, TemperatureUnit t_unit) : GeoAtmosDensityT() { configureOutputUnit(d_unit, t_unit); }
 
-	GeoAtmosDensity(const ModelConfig &config) : GeoAtmosDensity() { m_config = config; }
+	GeoAtmosDensityT(const ModelConfig &config) : GeoAtmosDensityT() {
+		static_assert(!is_static_config, "The model configuration of GeoAtmosDensityT<ModelConfig> is fixed at compile time.");
+		m_config = config;
+	}
 
 	template <class T>
-	auto operator()(const T &pos, double f107_average, double f107_daily, double ap) ->
+	auto operator()(const T &pos, double f107_average, double f107_daily, double ap) const ->
 	  typename std::enable_if_t<internal::HasToWgs84<T>::value, AtmosphericParameters> {
 		return gtd7Interface(pos.toWgs84(), f107_average, f107_daily, ap, nullptr);
 	}
 
 	template <class T>
-	auto operator()(const T &pos, double f107_average, double f107_daily, const MagneticIndex &ap) ->
+	auto operator()(const T &pos, double f107_average, double f107_daily, const MagneticIndex &ap) const ->
 	  typename std::enable_if_t<internal::HasToWgs84<T>::value, AtmosphericParameters> {
 		return gtd7Interface(pos.toWgs84(), f107_average, f107_daily, ap.ap[0], ap.ap);
 	}
 
 	template <class T>
-	auto operator()(const T &pos, const SpaceWeather &db) ->
+	auto operator()(const T &pos, const SpaceWeather &db) const ->
 	  typename std::enable_if_t<internal::HasToWgs84<T>::value, AtmosphericParameters> {
 		double f107_average = 0, f107_daily = 0;
 		MagneticIndex ap{};
 
-		pickOutSpDbF107Average(db, pos.epoch(), f107_average);
-		pickOutSpDbF107Daily(db, pos.epoch(), f107_daily);
-		pickOutSpDbAp(db, pos.epoch(), ap);
+		pickOutSpDb(db, pos.epoch(), f107_average, f107_daily, ap);
 
 		return operator()(pos.toWgs84(), f107_average, f107_daily, ap);
 	}
 
+	/**
+	 * @brief 大気パラメータを例外を投げずに計算する
+	 * @note 計算上の異常は例外ではなく status に返し, 計算は続行する
+	 *
+	 * @param pos 位置
+	 * @param f107_average F10.7 の81日中心平均値
+	 * @param f107_daily 前日の F10.7
+	 * @param ap 磁気指数
+	 * @param status 計算状態 (EvaluationStatus::Flag の論理和)
+	 */
+	template <class T>
+	auto operator()(const T &pos, double f107_average, double f107_daily, const MagneticIndex &ap, std::uint32_t &status) const noexcept
+	  -> typename std::enable_if_t<internal::HasToWgs84<T>::value, AtmosphericParameters> {
+		status = EvaluationStatus::Ok;
+		return gtd7Interface(pos.toWgs84(), f107_average, f107_daily, ap.ap[0], ap.ap, &status);
+	}
+
+	/**
+	 * @brief 大気パラメータを例外を投げずに計算する
+	 * @note 宇宙天気データが参照できない場合は既定値を使い, status にその旨を返す
+	 *
+	 * @param pos 位置
+	 * @param db 宇宙天気データベース
+	 * @param status 計算状態 (EvaluationStatus::Flag の論理和)
+	 */
+	template <class T>
+	auto operator()(const T &pos, const SpaceWeather &db, std::uint32_t &status) const noexcept
+	  -> typename std::enable_if_t<internal::HasToWgs84<T>::value, AtmosphericParameters> {
+		double f107_average = 0, f107_daily = 0;
+		MagneticIndex ap{};
+
+		status = pickOutSpDb(db, pos.epoch(), f107_average, f107_daily, ap);
+
+		return gtd7Interface(pos.toWgs84(), f107_average, f107_daily, ap.ap[0], ap.ap, &status);
+	}
+
+	/**
+	 * @brief 大気質量密度とその高度・緯度・経度についての偏微分を計算する
+	 * @note 偏微分は前進型自動微分により1回のモデル評価で求める (差分の刻みによらず, densu / densm の接続高度の前後でも正確).
+	 *       密度は operator() の結果と一致する
+	 *
+	 * @param pos 位置
+	 * @param f107_average F10.7 の81日中心平均値
+	 * @param f107_daily 前日の F10.7
+	 * @param ap 磁気指数
+	 */
+	template <class T>
+	auto gradient(const T &pos, double f107_average, double f107_daily, double ap) const ->
+	  typename std::enable_if_t<internal::HasToWgs84<T>::value, DensityGradient> {
+		return gradientInterface(pos.toWgs84(), f107_average, f107_daily, ap, nullptr);
+	}
+
+	/**
+	 * @brief 大気質量密度とその高度・緯度・経度についての偏微分を計算する
+	 *
+	 * @param pos 位置
+	 * @param f107_average F10.7 の81日中心平均値
+	 * @param f107_daily 前日の F10.7
+	 * @param ap 磁気指数
+	 */
+	template <class T>
+	auto gradient(const T &pos, double f107_average, double f107_daily, const MagneticIndex &ap) const ->
+	  typename std::enable_if_t<internal::HasToWgs84<T>::value, DensityGradient> {
+		return gradientInterface(pos.toWgs84(), f107_average, f107_daily, ap.ap[0], ap.ap);
+	}
+
+	/**
+	 * @brief 大気質量密度とその高度・緯度・経度についての偏微分を計算する
+	 *
+	 * @param pos 位置
+	 * @param db 宇宙天気データベース
+	 */
+	template <class T>
+	auto gradient(const T &pos, const SpaceWeather &db) const ->
+	  typename std::enable_if_t<internal::HasToWgs84<T>::value, DensityGradient> {
+		double f107_average = 0, f107_daily = 0;
+		MagneticIndex ap{};
+
+		pickOutSpDb(db, pos.epoch(), f107_average, f107_daily, ap);
+
+		return gradient(pos.toWgs84(), f107_average, f107_daily, ap);
+	}
+
+	/**
+	 * @brief 複数地点の大気パラメータを一括で計算する
+	 * @note 設定の変換は一度だけ行い, 宇宙天気データの参照は同じ3時間枠の地点間で共有する.
+	 *       球面調和展開は GEOATMOS_NRLMSISE_LANE_WIDTH 地点ずつベクトル化して計算するため,
+	 *       operator() の結果とは相対誤差 1e-12 以内で一致する (GEOATMOS_NRLMSISE_LANE_WIDTH=1 でビット一致)
+	 *       高度だけが異なる連続した地点は球面調和展開と高度帯ごとの中間値を共有する
+	 *
+	 * @param positions 位置 (エフェメリス)
+	 * @param db 宇宙天気データベース
+	 * @param output 出力先 (positions と同じ要素数)
+	 */
+	template <class T>
+	auto batch(std::span<T> positions, const SpaceWeather &db, std::span<AtmosphericParameters> output) const ->
+	  typename std::enable_if_t<internal::HasToWgs84<std::remove_const_t<T>>::value, void> {
+		validateBatchSize(positions.size(), output.size());
+		evaluateBatch(positions, output, nullptr, SpaceWeatherInput{*this, db});
+	}
+
+	/**
+	 * @brief 複数地点の大気パラメータを例外を投げずに一括で計算する
+	 * @note 計算上の異常は地点ごとに status に返し, 残りの地点の計算は続行する.
+	 *       要素数が一致しない場合は計算せず, status の全要素を EvaluationStatus::InvalidInput とする
+	 *
+	 * @param positions 位置 (エフェメリス)
+	 * @param db 宇宙天気データベース
+	 * @param output 出力先 (positions と同じ要素数)
+	 * @param status 各地点の計算状態 (positions と同じ要素数)
+	 */
+	template <class T>
+	auto batch(std::span<T> positions, const SpaceWeather &db, std::span<AtmosphericParameters> output,
+			   std::span<std::uint32_t> status) const noexcept
+	  -> typename std::enable_if_t<internal::HasToWgs84<std::remove_const_t<T>>::value, void> {
+		if (!checkBatchSize(positions.size(), output.size(), status)) return;
+		evaluateBatch(positions, output, status.data(), SpaceWeatherInput{*this, db});
+	}
+
+	/**
+	 * @brief 複数地点の大気パラメータを一括で計算する
+	 *
+	 * @param positions 位置 (エフェメリス)
+	 * @param f107_average F10.7 の81日中心平均値
+	 * @param f107_daily 前日の F10.7
+	 * @param ap 磁気指数
+	 * @param output 出力先 (positions と同じ要素数)
+	 */
+	template <class T>
+	auto batch(std::span<T> positions, double f107_average, double f107_daily, const MagneticIndex &ap,
+			   std::span<AtmosphericParameters> output) const ->
+	  typename std::enable_if_t<internal::HasToWgs84<std::remove_const_t<T>>::value, void> {
+		validateBatchSize(positions.size(), output.size());
+		evaluateBatch(positions, output, nullptr, FixedInput{*this, f107_average, f107_daily, ap});
+	}
+
+	/**
+	 * @brief 複数地点の大気パラメータを例外を投げずに一括で計算する
+	 * @note 要素数が一致しない場合は計算せず, status の全要素を EvaluationStatus::InvalidInput とする
+	 *
+	 * @param positions 位置 (エフェメリス)
+	 * @param f107_average F10.7 の81日中心平均値
+	 * @param f107_daily 前日の F10.7
+	 * @param ap 磁気指数
+	 * @param output 出力先 (positions と同じ要素数)
+	 * @param status 各地点の計算状態 (positions と同じ要素数)
+	 */
+	template <class T>
+	auto batch(std::span<T> positions, double f107_average, double f107_daily, const MagneticIndex &ap,
+			   std::span<AtmosphericParameters> output, std::span<std::uint32_t> status) const noexcept
+	  -> typename std::enable_if_t<internal::HasToWgs84<std::remove_const_t<T>>::value, void> {
+		if (!checkBatchSize(positions.size(), output.size(), status)) return;
+		evaluateBatch(positions, output, status.data(), FixedInput{*this, f107_average, f107_daily, ap});
+	}
+
+	/**
+	 * @brief 複数地点の大気パラメータを一括で計算する
+	 *
+	 * @param positions 位置 (エフェメリス)
+	 * @param db 宇宙天気データベース
+	 * @return std::vector<AtmosphericParameters> 各地点の大気パラメータ
+	 */
+	template <class T>
+	auto batch(const std::vector<T> &positions, const SpaceWeather &db) const ->
+	  typename std::enable_if_t<internal::HasToWgs84<T>::value, std::vector<AtmosphericParameters>> {
+		std::vector<AtmosphericParameters> output(positions.size());
+		batch(std::span{positions}, db, std::span{output});
+		return output;
+	}
+
+	/**
+	 * @brief 鉛直プロファイル (同じ時刻・地点の複数高度) の大気パラメータを計算する
+	 * @note 球面調和展開と高度帯ごとの温度プロファイル・下端密度は1回だけ計算し, 高度ごとには densu / densm のみを評価する.
+	 *       結果は operator() と一致する
+	 *
+	 * @param epoch 時刻
+	 * @param longitude 経度
+	 * @param latitude 緯度
+	 * @param altitudes 高度 [m]
+	 * @param db 宇宙天気データベース
+	 * @param output 出力先 (altitudes と同じ要素数)
+	 */
+	void profile(const DateTime &epoch, const Angle &longitude, const Angle &latitude, std::span<const double> altitudes,
+				 const SpaceWeather &db, std::span<AtmosphericParameters> output) const {
+		double f107_average = 0, f107_daily = 0;
+		MagneticIndex ap{};
+
+		pickOutSpDb(db, epoch, f107_average, f107_daily, ap);
+
+		profile(epoch, longitude, latitude, altitudes, f107_average, f107_daily, ap, output);
+	}
+
+	/**
+	 * @brief 鉛直プロファイル (同じ時刻・地点の複数高度) の大気パラメータを計算する
+	 *
+	 * @param epoch 時刻
+	 * @param longitude 経度
+	 * @param latitude 緯度
+	 * @param altitudes 高度 [m]
+	 * @param f107_average F10.7 の81日中心平均値
+	 * @param f107_daily 前日の F10.7
+	 * @param ap 磁気指数
+	 * @param output 出力先 (altitudes と同じ要素数)
+	 */
+	void profile(const DateTime &epoch, const Angle &longitude, const Angle &latitude, std::span<const double> altitudes,
+				 double f107_average, double f107_daily, const MagneticIndex &ap, std::span<AtmosphericParameters> output) const;
+
+	/**
+	 * @brief 鉛直プロファイル (同じ時刻・地点の複数高度) の大気パラメータを計算する
+	 *
+	 * @param epoch 時刻
+	 * @param longitude 経度
+	 * @param latitude 緯度
+	 * @param altitudes 高度 [m]
+	 * @param db 宇宙天気データベース
+	 * @return std::vector<AtmosphericParameters> 各高度の大気パラメータ
+	 */
+	std::vector<AtmosphericParameters> profile(const DateTime &epoch, const Angle &longitude, const Angle &latitude,
+											   const std::vector<double> &altitudes, const SpaceWeather &db) const {
+		std::vector<AtmosphericParameters> output(altitudes.size());
+		profile(epoch, longitude, latitude, std::span{altitudes}, db, std::span{output});
+		return output;
+	}
+
 	// void configureModel(const ModelConfig &config) { m_config = config; }
 
 	void configureOutputUnit(DensityUnit d_unit, TemperatureUnit t_unit) {
+		static_assert(!is_static_config, "The output unit of GeoAtmosDensityT<ModelConfig> is fixed at compile time.");
 		switch (d_unit) {
 			case DensityUnit::GramPerCm3:
 			case DensityUnit::Cgs: {
@@ -102,113 +351,368 @@ class GeoAtmosDensity : private internal::Nrlmsise {
 	}
 
   private:
+	/**
+	 * @brief 日付分解の結果を同じ日の地点間で使い回すためのキャッシュ
+	 *
+	 */
+	struct DayCache {
+		std::int64_t day = std::numeric_limits<std::int64_t>::min();
+		int year = 0;
+		int doy = 0;
+	};
+
+	/**
+	 * @brief 一括計算で地点の入力を設定する (宇宙天気データベースを参照する場合)
+	 * @note 宇宙天気データの参照は同じ3時間枠の地点間で使い回す
+	 *
+	 */
+	struct SpaceWeatherInput {
+		const GeoAtmosDensityT &model;
+		const SpaceWeather &db;
+		std::int64_t slot = std::numeric_limits<std::int64_t>::min();
+		double f107_average = 0, f107_daily = 0;
+		MagneticIndex ap{};
+		std::uint32_t status = EvaluationStatus::Ok;
+
+		std::uint32_t operator()(internal::NrlmsiseInput &nv_input, const Wgs84 &pos, DayCache &day_cache);
+	};
+
+	/**
+	 * @brief 一括計算で地点の入力を設定する (全地点で同じ指数を使う場合)
+	 *
+	 */
+	struct FixedInput {
+		const GeoAtmosDensityT &model;
+		double f107_average, f107_daily;
+		const MagneticIndex &ap;
+
+		std::uint32_t operator()(internal::NrlmsiseInput &nv_input, const Wgs84 &pos, DayCache &day_cache) const;
+	};
+
 	ModelConfig m_config;
-	internal::NrlmsiseInput m_nv_input;
-	internal::NrlmsiseOutput m_nv_output;
-	internal::NrlmsiseConfig m_nv_config;
 	double temperature_offset;
 
+	template <bool SpecificAp>
+	auto nativeConfig() const;
+
+	template <class T, class SetInput>
+	void evaluateBatch(std::span<T> positions, std::span<AtmosphericParameters> output, std::uint32_t *status, SetInput &&set_input) const;
 	AtmosphericParameters gtd7Interface(const Wgs84 &pos, const double &f107_average, const double &f107_daily, const double &ap,
-										const double *ap_array, const double &lst = std::numeric_limits<double>::infinity());
-	bool pickOutSpDbF107Daily(const SpaceWeather &db, const DateTime &dt, double &f107_daily);
-	bool pickOutSpDbF107Average(const SpaceWeather &db, const DateTime &dt, double &f107_average);
-	bool pickOutSpDbAp(const SpaceWeather &db, const DateTime &dt, MagneticIndex &ap);
+										const double *ap_array, std::uint32_t *status = nullptr,
+										const double &lst = std::numeric_limits<double>::infinity()) const;
+	DensityGradient gradientInterface(const Wgs84 &pos, const double &f107_average, const double &f107_daily, const double &ap,
+									  const double *ap_array) const;
+	void setNativeInput(internal::NrlmsiseInput &nv_input, const Wgs84 &pos, DayCache &day_cache, const double &f107_average,
+						const double &f107_daily, const double &ap, const double *ap_array,
+						const double &lst = std::numeric_limits<double>::infinity()) const;
+	AtmosphericParameters nativeOutput(const internal::NrlmsiseOutput &nv_output, const ModelConfig &config) const;
+	static std::uint32_t outputStatus(const internal::NrlmsiseOutput &nv_output, const internal::NrlmsiseWorkspace &ws);
+	void validateBatchSize(std::size_t input_size, std::size_t output_size) const;
+	bool checkBatchSize(std::size_t input_size, std::size_t output_size, std::span<std::uint32_t> status) const noexcept;
+	std::uint32_t pickOutSpDb(const SpaceWeather &db, const DateTime &dt, double &f107_average, double &f107_daily,
+							  MagneticIndex &ap) const;
 };
 
-AtmosphericParameters GeoAtmosDensity::gtd7Interface(const Wgs84 &pos, const double &f107_average, const double &f107_daily,
-													 const double &ap, const double *ap_array, const double &lst) {
-	// 入出力設定
-	if (ap_array) m_config.daily_ap = SwitchStatus::Specific;
-	m_nv_config = m_config.convertNativeStatus();
+template <auto Config, class GlobeScalar>
+std::uint32_t GeoAtmosDensityT<Config, GlobeScalar>::SpaceWeatherInput::operator()(internal::NrlmsiseInput &nv_input, const Wgs84 &pos,
+																				 DayCache &day_cache) {
+	const std::int64_t pos_slot = pos.epoch().ticks() / (3 * constant::ticks_per_hour);
+	if (pos_slot != slot) {
+		status = model.pickOutSpDb(db, pos.epoch(), f107_average, f107_daily, ap);
+		slot = pos_slot;
+	}
+	model.setNativeInput(nv_input, pos, day_cache, f107_average, f107_daily, ap.ap[0], ap.ap);
+	return status;
+}
+
+template <auto Config, class GlobeScalar>
+std::uint32_t GeoAtmosDensityT<Config, GlobeScalar>::FixedInput::operator()(internal::NrlmsiseInput &nv_input, const Wgs84 &pos,
+																		  DayCache &day_cache) const {
+	model.setNativeInput(nv_input, pos, day_cache, f107_average, f107_daily, ap.ap[0], ap.ap);
+	return EvaluationStatus::Ok;
+}
 
-	// 入力
-	{
-		m_nv_input.alt = pos.altitude() * 1e-3; // m -> km
-		m_nv_input.g_lat = pos.latitude().degrees();
-		m_nv_input.g_long = pos.longitude().degrees();
-		m_nv_input.year = pos.epoch().year();
-		m_nv_input.doy = pos.epoch().dayOfYear();
-		m_nv_input.sec = pos.epoch().secondsOfDay();
-		m_nv_input.lst = (std::isfinite(lst)) ? lst : m_nv_input.sec / 3600.0 + m_nv_input.g_long / 15.0;
-		m_nv_input.f107A = f107_average;
-		m_nv_input.f107 = f107_daily;
-		if (ap_array) {
-			std::copy(ap_array, ap_array + std::size(m_nv_input.ap_a.a), m_nv_input.ap_a.a);
+/**
+ * @brief 地点をブロックごとにまとめ, 球面調和展開をベクトル化して計算する
+ * @note 時刻・地点が同じで高度だけが異なる連続した地点は, 球面調和展開と高度帯ごとの中間値を1回だけ計算して共有する
+ *
+ * @param status 各地点の計算状態の出力先 (nullptr の場合は計算上の異常を例外で通知する)
+ * @param set_input 地点の入力を設定し, 入力の状態を返す関数 (nv_input, pos, day_cache)
+ */
+template <auto Config, class GlobeScalar>
+template <class T, class SetInput>
+void GeoAtmosDensityT<Config, GlobeScalar>::evaluateBatch(std::span<T> positions, std::span<AtmosphericParameters> output,
+														  std::uint32_t *status, SetInput &&set_input) const {
+	constexpr int lanes = internal::nrlmsise_lane_width * static_cast<int>(sizeof(double) / sizeof(GlobeScalar));
+	constexpr int block = 16 * lanes;
+
+	const auto nv_config = nativeConfig<true>();
+
+	internal::NrlmsiseInput nv_input[block]{};
+	internal::NrlmsiseInputLanes<lanes, GlobeScalar> lane_input;
+	internal::NrlmsiseGlobeTerms terms[block];
+	int column[block]; // 地点が参照する球面調和展開
+	int head[block];   // 球面調和展開を計算する地点 (列内で最も低い高度)
+	std::uint32_t input_status[block];
+	internal::NrlmsiseOutput nv_output{};
+	internal::NrlmsiseWorkspace ws{};
+	internal::NrlmsiseColumnCache cache;
+	DayCache day_cache;
+	ws.nothrow = (status != nullptr);
+
+	for (std::size_t i = 0; i < positions.size(); i += block) {
+		const int n = static_cast<int>(std::min<std::size_t>(block, positions.size() - i));
+		int columns = 0;
+		for (int k = 0; k < n; k++) {
+			input_status[k] = set_input(nv_input[k], positions[i + k].toWgs84(), day_cache);
+			if (columns == 0 || !internal::sharesGlobeTerms(nv_input[k], nv_input[head[columns - 1]])) {
+				head[columns++] = k;
+			} else if (nv_input[k].alt < nv_input[head[columns - 1]].alt) {
+				head[columns - 1] = k;
+			}
+			column[k] = columns - 1;
+		}
+
+		if constexpr (lanes > 1) {
+			for (int c = 0; c < columns; c += lanes) {
+				// 端数のレーンは最後の列で埋める
+				const int w = std::min(lanes, columns - c);
+				for (int l = 0; l < lanes; l++) lane_input.set(l, nv_input[head[c + std::min(l, w - 1)]]);
+				globeTermsLanes(lane_input, nv_config, &terms[c]);
+			}
 		} else {
-			m_nv_input.ap = ap;
+			for (int c = 0; c < columns; c++) globeTerms(nv_input[head[c]], nv_config, terms[c]);
+		}
+
+		for (int k = 0; k < n; k++) {
+			if (k == 0 || column[k] != column[k - 1]) cache.reset();
+			ws.status = EvaluationStatus::Ok;
+			gtd7(nv_input[k], nv_config, nv_output, ws, &terms[column[k]], &cache);
+			output[i + k] = nativeOutput(nv_output, m_config);
+			if (status) status[i + k] = input_status[k] | outputStatus(nv_output, ws);
 		}
 	}
+}
 
-	// モデル計算
-	gtd7(m_nv_input, m_nv_config, m_nv_output);
+template <auto Config, class GlobeScalar>
+void GeoAtmosDensityT<Config, GlobeScalar>::profile(const DateTime &epoch, const Angle &longitude, const Angle &latitude,
+													std::span<const double> altitudes, double f107_average, double f107_daily,
+													const MagneticIndex &ap, std::span<AtmosphericParameters> output) const {
+	validateBatchSize(altitudes.size(), output.size());
+	if (altitudes.empty()) return;
+
+	const auto nv_config = nativeConfig<true>();
+
+	internal::NrlmsiseInput nv_input{};
+	DayCache day_cache;
+	setNativeInput(nv_input, Wgs84{epoch, longitude, latitude, 0.0}, day_cache, f107_average, f107_daily, ap.ap[0], ap.ap);
+
+	// 最も低い高度で計算した球面調和展開は全ての高度を覆う
+	internal::NrlmsiseGlobeTerms terms;
+	nv_input.alt = *std::min_element(altitudes.begin(), altitudes.end()) * 1e-3; // m -> km
+	globeTerms(nv_input, nv_config, terms);
+
+	internal::NrlmsiseColumnCache cache;
+	internal::NrlmsiseOutput nv_output{};
+	for (std::size_t i = 0; i < altitudes.size(); i++) {
+		// 高度間で共有するのは cache だけにし, 作業領域は高度ごとに初期化する (operator() と同じ状態から計算する)
+		internal::NrlmsiseWorkspace ws{};
+		nv_input.alt = altitudes[i] * 1e-3; // m -> km
+		gtd7(nv_input, nv_config, nv_output, ws, &terms, &cache);
+		output[i] = nativeOutput(nv_output, m_config);
+	}
+}
 
-	DensityUnit dens_unit = m_config.mks_unit_conversion == SwitchStatus::On ? DensityUnit::KgPerM3 : DensityUnit::GramPerCm3;
-	TemperatureUnit temp_unit = m_config.degc_unit_conversion == SwitchStatus::On ? TemperatureUnit::Celsius : TemperatureUnit::Kelvin;
+template <auto Config, class GlobeScalar>
+AtmosphericParameters GeoAtmosDensityT<Config, GlobeScalar>::gtd7Interface(const Wgs84 &pos, const double &f107_average,
+																		   const double &f107_daily, const double &ap,
+																		   const double *ap_array, std::uint32_t *status,
+																		   const double &lst) const {
+	// 入力
+	internal::NrlmsiseInput nv_input{};
+	DayCache day_cache;
+	setNativeInput(nv_input, pos, day_cache, f107_average, f107_daily, ap, ap_array, lst);
+
+	// モデル計算
+	internal::NrlmsiseOutput nv_output{};
+	internal::NrlmsiseWorkspace ws{};
+	ws.nothrow = (status != nullptr);
+	if (ap_array) {
+		gtd7(nv_input, nativeConfig<true>(), nv_output, ws);
+	} else {
+		gtd7(nv_input, nativeConfig<false>(), nv_output, ws);
+	}
 
 	// 出力
-	return {{
-			  m_nv_output.d[6],
-			  m_nv_output.d[0],
-			  m_nv_output.d[7],
-			  m_nv_output.d[1],
-			  m_nv_output.d[4],
-			  m_nv_output.d[2],
-			  m_nv_output.d[3],
-			  m_nv_output.d[8],
-			  m_nv_output.d[5],
-			  dens_unit,
-			},
-			{m_nv_output.t[0] - temperature_offset, m_nv_output.t[1] - temperature_offset, temp_unit}};
+	if (status) *status |= outputStatus(nv_output, ws);
+	return nativeOutput(nv_output, m_config);
 }
 
-bool GeoAtmosDensity::pickOutSpDbF107Daily(const SpaceWeather &db, const DateTime &dt, double &f107_daily) {
-	try {
-		f107_daily = db.adjustedF107(dt - Days(1));
-		return true;
-	} catch (const std::out_of_range &e) {
-		f107_daily = 150;
-		return false;
+/**
+ * @brief 高度 [km]・緯度 [deg]・経度 [deg] を独立変数とする2重数で gtd7 を評価し, 偏微分を高度 [m]・緯度 [rad]・経度 [rad] についての値に換算する
+ * @note 地方時は経度から求めるため, 経度についての偏微分には地方時の変化も含まれる
+ *
+ */
+template <auto Config, class GlobeScalar>
+DensityGradient GeoAtmosDensityT<Config, GlobeScalar>::gradientInterface(const Wgs84 &pos, const double &f107_average,
+																		 const double &f107_daily, const double &ap,
+																		 const double *ap_array) const {
+	using Dual = internal::NrlmsiseDual<3>;
+
+	// 入力
+	internal::NrlmsiseInput nv_input{};
+	DayCache day_cache;
+	setNativeInput(nv_input, pos, day_cache, f107_average, f107_daily, ap, ap_array);
+
+	internal::NrlmsiseInputT<Dual> dual_input{};
+	dual_input.year = nv_input.year;
+	dual_input.doy = nv_input.doy;
+	dual_input.sec = nv_input.sec;
+	dual_input.alt = Dual::variable(nv_input.alt, 0);
+	dual_input.g_lat = Dual::variable(nv_input.g_lat, 1);
+	dual_input.g_long = Dual::variable(nv_input.g_long, 2);
+	dual_input.lst = nv_input.sec / 3600.0 + dual_input.g_long / 15.0;
+	dual_input.f107A = nv_input.f107A;
+	dual_input.f107 = nv_input.f107;
+	dual_input.ap = nv_input.ap;
+	dual_input.ap_a = nv_input.ap_a;
+
+	// モデル計算
+	internal::NrlmsiseOutputT<Dual> nv_output{};
+	internal::NrlmsiseWorkspaceT<Dual> ws{};
+	if (ap_array) {
+		gtd7(dual_input, nativeConfig<true>(), nv_output, ws);
+	} else {
+		gtd7(dual_input, nativeConfig<false>(), nv_output, ws);
 	}
+
+	// 出力
+	constexpr double per_degree = 180.0 / constant::pi;
+	const Dual &rho = nv_output.d[5];
+	const DensityUnit unit = m_config.mks_unit_conversion == SwitchStatus::On ? DensityUnit::KgPerM3 : DensityUnit::GramPerCm3;
+	return {rho.value(), rho.derivative(0) * 1e-3, rho.derivative(1) * per_degree, rho.derivative(2) * per_degree, unit};
 }
 
-bool GeoAtmosDensity::pickOutSpDbF107Average(const SpaceWeather &db, const DateTime &dt, double &f107_average) {
-	try {
-		f107_average = db.adjustedF107Center81(dt);
-		return true;
-	} catch (const std::out_of_range &e) {
-		f107_average = 150;
-		return false;
+/**
+ * @brief NRLMSISE-00 に渡すスイッチ
+ * @note Config が ModelConfig の場合はコンパイル時に決まる StaticConfig を返す
+ *
+ * @tparam SpecificAp 3時間ごとの Ap の履歴を使う (daily_ap = SwitchStatus::Specific)
+ */
+template <auto Config, class GlobeScalar>
+template <bool SpecificAp>
+auto GeoAtmosDensityT<Config, GlobeScalar>::nativeConfig() const {
+	if constexpr (is_static_config) {
+		constexpr ModelConfig config = [] {
+			ModelConfig c = Config;
+			if (SpecificAp) c.daily_ap = SwitchStatus::Specific;
+			return c;
+		}();
+		return StaticConfig<config>{};
+	} else {
+		auto config = m_config;
+		if (SpecificAp) config.daily_ap = SwitchStatus::Specific;
+		auto nv_config = config.convertNativeStatus();
+		tselec(nv_config);
+		return nv_config;
 	}
 }
 
-bool GeoAtmosDensity::pickOutSpDbAp(const SpaceWeather &db, const DateTime &dt, MagneticIndex &ap) {
-	constexpr double time_step = -3.0;	  // -3h
-	constexpr int avg_times = 8;		  // 8 times
-	constexpr int m12_m33_start = 12 / 3; // -12h
-	constexpr int m12_m33_end = 33 / 3;	  // -33h
-	constexpr int m36_m57_start = 36 / 3; // -36h
-	constexpr int m36_m57_end = 57 / 3;	  // -57h
+template <auto Config, class GlobeScalar>
+void GeoAtmosDensityT<Config, GlobeScalar>::setNativeInput(internal::NrlmsiseInput &nv_input, const Wgs84 &pos, DayCache &day_cache,
+														   const double &f107_average, const double &f107_daily, const double &ap,
+														   const double *ap_array, const double &lst) const {
+	const std::int64_t day = pos.epoch().ticks() / constant::ticks_per_day;
+	if (day != day_cache.day) {
+		day_cache.day = day;
+		const CivilDate date = pos.epoch().civil();
+		day_cache.year = date.year;
+		day_cache.doy = date.day_of_year;
+	}
 
-	try {
-		// Daily AP
-		ap.ap[0] = db.dailyApIndex(dt);
+	nv_input.alt = pos.altitude() * 1e-3; // m -> km
+	nv_input.g_lat = pos.latitude().degrees();
+	nv_input.g_long = pos.longitude().degrees();
+	nv_input.year = day_cache.year;
+	nv_input.doy = day_cache.doy;
+	nv_input.sec = pos.epoch().secondsOfDay();
+	nv_input.lst = (std::isfinite(lst)) ? lst : nv_input.sec / 3600.0 + nv_input.g_long / 15.0;
+	nv_input.f107A = f107_average;
+	nv_input.f107 = f107_daily;
+	if (ap_array) {
+		std::copy(ap_array, ap_array + std::size(nv_input.ap_a.a), nv_input.ap_a.a);
+	} else {
+		nv_input.ap = ap;
+	}
+}
 
-		// 3h AP from 0h, -3h, -6h, -9h
-		for (int i = 1; i < 5; i++) ap.ap[i] = db.apIndex(dt, Hours{time_step * (i - 1)});
+template <auto Config, class GlobeScalar>
+AtmosphericParameters GeoAtmosDensityT<Config, GlobeScalar>::nativeOutput(const internal::NrlmsiseOutput &nv_output,
+																		  const ModelConfig &config) const {
+	DensityUnit dens_unit = config.mks_unit_conversion == SwitchStatus::On ? DensityUnit::KgPerM3 : DensityUnit::GramPerCm3;
+	TemperatureUnit temp_unit = config.degc_unit_conversion == SwitchStatus::On ? TemperatureUnit::Celsius : TemperatureUnit::Kelvin;
 
-		// Average 3h AP from -12h ~ -33h
-		for (int i = m12_m33_start; i < m12_m33_end; i++) ap.ap[5] += (double)db.apIndex(dt, Hours{time_step * i});
-		ap.ap[5] /= (double)avg_times;
+	return {{
+			  nv_output.d[6],
+			  nv_output.d[0],
+			  nv_output.d[7],
+			  nv_output.d[1],
+			  nv_output.d[4],
+			  nv_output.d[2],
+			  nv_output.d[3],
+			  nv_output.d[8],
+			  nv_output.d[5],
+			  dens_unit,
+			},
+			{nv_output.t[0] - temperature_offset, nv_output.t[1] - temperature_offset, temp_unit}};
+}
 
-		// Average 3h AP from -36h ~ -57h
-		for (int i = m36_m57_start; i < m36_m57_end; i++) ap.ap[6] += (double)db.apIndex(dt, Hours{time_step * i});
-		ap.ap[6] /= (double)avg_times;
+template <auto Config, class GlobeScalar>
+std::uint32_t GeoAtmosDensityT<Config, GlobeScalar>::outputStatus(const internal::NrlmsiseOutput &nv_output,
+																  const internal::NrlmsiseWorkspace &ws) {
+	std::uint32_t status = ws.status;
+	if (!std::isfinite(nv_output.d[5]) || !std::isfinite(nv_output.t[1])) status |= EvaluationStatus::MathDomainError;
+	return status;
+}
 
-		return true;
-	} catch (const std::out_of_range &e) {
-		ap = MagneticIndex{};
-		return false;
+template <auto Config, class GlobeScalar>
+void GeoAtmosDensityT<Config, GlobeScalar>::validateBatchSize(std::size_t input_size, std::size_t output_size) const {
+	if (input_size != output_size) {
+		throw AtmosModelException("Output buffer size does not match the number of positions.", AtmosModelException::InvalidValue);
 	}
 }
 
+template <auto Config, class GlobeScalar>
+bool GeoAtmosDensityT<Config, GlobeScalar>::checkBatchSize(std::size_t input_size, std::size_t output_size,
+														   std::span<std::uint32_t> status) const noexcept {
+	if (input_size == output_size && input_size == status.size()) return true;
+	std::fill(status.begin(), status.end(), EvaluationStatus::InvalidInput);
+	return false;
+}
+
+template <auto Config, class GlobeScalar>
+std::uint32_t GeoAtmosDensityT<Config, GlobeScalar>::pickOutSpDb(const SpaceWeather &db, const DateTime &dt, double &f107_average,
+																 double &f107_daily, MagneticIndex &ap) const {
+	constexpr std::uint8_t all = SpaceWeatherSlot::HasAp | SpaceWeatherSlot::HasF107Average | SpaceWeatherSlot::HasF107Daily;
+	const SpaceWeatherSlot *slot = db.slot(dt);
+	const std::uint8_t flags = slot ? slot->flags : 0;
+
+	// 参照できない項目は既定値 (F10.7 = 150, Ap = 4) を使う
+	f107_average = (flags & SpaceWeatherSlot::HasF107Average) ? slot->f107_average : 150;
+	f107_daily = (flags & SpaceWeatherSlot::HasF107Daily) ? slot->f107_daily : 150;
+	ap = MagneticIndex{};
+	if (flags & SpaceWeatherSlot::HasAp) std::copy(std::begin(slot->ap), std::end(slot->ap), ap.ap);
+
+	std::uint32_t status = EvaluationStatus::Ok;
+	if (!(flags & SpaceWeatherSlot::HasF107Average)) status |= EvaluationStatus::SpaceWeatherOutOfRange; // 当日のデータがない
+	if (flags != all) status |= EvaluationStatus::SpaceWeatherFallback;
+	return status;
+}
+
+/**
+ * @brief 実行時にモデル設定を変更できる地球大気モデル
+ *
+ */
+using GeoAtmosDensity = GeoAtmosDensityT<>;
+
 GEOATMOS_NAMESPACE_END
\ No newline at end of file
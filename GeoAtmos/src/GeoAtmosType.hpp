@@ -37,30 +37,37 @@ namespace internal {
 
 	/**
 	 * @brief NRLMSISE-00 Atmosphere Model Input
+	 * @note S は double, または位置 (高度・緯度・経度・地方時) についての微分を持つ NrlmsiseDual
 	 *
 	 */
-	struct NrlmsiseInput {
+	template <class S>
+	struct NrlmsiseInputT {
 		int year;
 		int doy;
 		double sec;
-		double alt;
-		double g_lat;
-		double g_long;
-		double lst;
+		S alt;
+		S g_lat;
+		S g_long;
+		S lst;
 		double f107A;
 		double f107;
 		double ap;
 		ApArray ap_a;
 	};
 
+	using NrlmsiseInput = NrlmsiseInputT<double>;
+
 	/**
 	 * @brief NRLMSISE-00 Atmosphere Model Output
 	 *
 	 */
-	struct NrlmsiseOutput {
-		double d[9]; /* densities */
-		double t[2]; /* temperatures */
+	template <class S>
+	struct NrlmsiseOutputT {
+		S d[9]; /* densities */
+		S t[2]; /* temperatures */
 	};
+
+	using NrlmsiseOutput = NrlmsiseOutputT<double>;
 } // namespace internal
 
 /**
@@ -71,6 +78,7 @@ enum class SwitchStatus : std::int8_t { Off, On, Specific };
 
 /**
  * @brief NRLMSISE-00 のモデル設定
+ * @note constexpr で構築でき, GeoAtmosDensityT のテンプレート引数として使える
  *
  */
 struct ModelConfig {
@@ -100,7 +108,7 @@ struct ModelConfig {
 	SwitchStatus var_all_low_mesosphere_temp;
 	SwitchStatus var_turbopause_scale_height;
 
-	ModelConfig()
+	constexpr ModelConfig()
 	  : degc_unit_conversion(SwitchStatus::Off),
 		mks_unit_conversion(SwitchStatus::Off),
 		f107_effect(SwitchStatus::On),
@@ -127,7 +135,7 @@ struct ModelConfig {
 		var_all_low_mesosphere_temp(SwitchStatus::On),
 		var_turbopause_scale_height(SwitchStatus::On) {}
 
-	internal::NrlmsiseConfig convertNativeStatus() const {
+	constexpr internal::NrlmsiseConfig convertNativeStatus() const {
 		internal::NrlmsiseConfig config;
 		config.switches[0] = static_cast<int>(mks_unit_conversion);
 		config.switches[1] = static_cast<int>(f107_effect);
@@ -161,6 +169,12 @@ struct ModelConfig {
 	}
 };
 
+/**
+ * @brief モデル設定を実行時に与えることを表す (GeoAtmosDensityT の既定のテンプレート引数)
+ *
+ */
+struct RuntimeModelConfig {};
+
 /**
  * @brief 磁気指数 (Ap)
  *
@@ -174,6 +188,21 @@ struct MagneticIndex {
 	  : ap{ap_a, ap_kp, ap_ao, ap_ap, ap_ae, ap_al, ap_af} {}
 };
 
+/**
+ * @brief 大気パラメータの計算状態 (Flag の論理和, 0 は正常)
+ *
+ */
+struct EvaluationStatus {
+	enum Flag : std::uint32_t {
+		Ok = 0,
+		SpaceWeatherOutOfRange = 1 << 0, // 時刻の宇宙天気データがデータベースにない
+		SpaceWeatherFallback = 1 << 1,	 // 参照できない宇宙天気データを既定値 (F10.7 = 150, Ap = 4) で補った
+		MathDomainError = 1 << 2,		 // 計算途中で定義域外の演算が発生した (結果は NaN となりうる)
+		NotConverged = 1 << 3,			 // 反復計算が収束しなかった
+		InvalidInput = 1 << 4,			 // 入力が不正で計算しなかった
+	};
+};
+
 enum class DensityUnit { GramPerCm3, KgPerM3, Cgs, Mks, Si };
 enum class TemperatureUnit { Kelvin, Celsius };
 
@@ -233,6 +262,22 @@ struct Temperature {
 	  : at_exosphere(at_exosphere), at_altitude(at_altitude), unit(unit) {}
 };
 
+/**
+ * @brief 大気質量密度とその測地座標についての偏微分
+ *
+ */
+struct DensityGradient {
+	double density;	  // 大気質量密度 [g/cm^3 or kg/m^3]
+	double altitude;  // 楕円体高についての偏微分 ∂ρ/∂h [(密度の単位)/m]
+	double latitude;  // 測地緯度についての偏微分 ∂ρ/∂φ [(密度の単位)/rad]
+	double longitude; // 経度についての偏微分 ∂ρ/∂λ [(密度の単位)/rad]
+	DensityUnit unit; // 密度の単位
+
+	DensityGradient() : density(0), altitude(0), latitude(0), longitude(0), unit(DensityUnit::GramPerCm3) {}
+	DensityGradient(double density, double altitude, double latitude, double longitude, DensityUnit unit)
+	  : density(density), altitude(altitude), latitude(latitude), longitude(longitude), unit(unit) {}
+};
+
 /**
  * @brief 大気パラメータ
  *
@@ -140,6 +140,9 @@ namespace constant {
 		constexpr double wgs84_a = 6378137.0;	   // WGS84楕円体の長半径 [m]
 		constexpr double wgs84_b = 6356752.314245; // WGS84楕円体の短半径 [m]
 
+		/* 地球の自転 */
+		constexpr double earth_rotation_rate = 7.292115e-5; // 地球自転角速度 [rad/s]
+
 		/* 摂動係数 */
 		constexpr double xke = 0.0743669161331734132; // 60 / sqrt(ae^3/mu)
 		constexpr double xj2 = 1.082616e-3;			  // j2項
@@ -8,6 +8,9 @@
  * @copyright Copyright (c) 2023
  *
  */
+
+#pragma once
+
 #include "Essential.hpp"
 
 GEOATMOS_NAMESPACE_BEGIN
@@ -21,23 +24,23 @@ class ModelSet {
 	ModelSet() = default;
 
   protected:
-	static double pt[150];
-	static double pd[9][150];
-	static double ps[150];
-	static double pdl[2][25];
-	static double ptm[10];
-	static double pdm[8][10];
-	static double ptl[4][100];
-	static double pma[10][100];
-	static double sam[100];
-	static double pavgm[10];
+	static const double pt[150];
+	static const double pd[9][150];
+	static const double ps[150];
+	static const double pdl[2][25];
+	static const double ptm[10];
+	static const double pdm[8][10];
+	static const double ptl[4][100];
+	static const double pma[10][100];
+	static const double sam[100];
+	static const double pavgm[10];
 
   private:
 };
 
 // clang-format off
 /* TEMPERATURE */
-double ModelSet::pt[150] = {
+inline const double ModelSet::pt[150] = {
     9.86573E-01, 1.62228E-02, 1.55270E-02,-1.04323E-01,-3.75801E-03,
     -1.18538E-03,-1.24043E-01, 4.56820E-03, 8.76018E-03,-1.36235E-01,
     -3.52427E-02, 8.84181E-03,-5.92127E-03,-8.61650E+00, 0.00000E+00,
@@ -70,7 +73,7 @@ double ModelSet::pt[150] = {
     0.00000E+00, 0.00000E+00, 0.00000E+00, 0.00000E+00, 0.00000E+00
 };
 
-double ModelSet::pd[9][150] = {
+inline const double ModelSet::pd[9][150] = {
     /* HE DENSITY*/
     {
         1.09979E+00,-4.88060E-02,-1.97501E-01,-9.10280E-02,-6.96558E-03,
@@ -371,7 +374,7 @@ double ModelSet::pd[9][150] = {
 };
 
 /*S PARAM */
-double ModelSet::ps[150] = {
+inline const double ModelSet::ps[150] = {
     9.56827E-01, 6.20637E-02, 3.18433E-02, 0.00000E+00, 0.00000E+00,
     3.94900E-02, 0.00000E+00, 0.00000E+00,-9.24882E-03,-7.94023E-03,
     0.00000E+00, 0.00000E+00, 0.00000E+00, 1.74712E+02, 0.00000E+00,
@@ -405,7 +408,7 @@ double ModelSet::ps[150] = {
 };
 
 /* TURBO */
-double ModelSet::pdl[2][25] = {
+inline const double ModelSet::pdl[2][25] = {
     {
         1.09930E+00, 3.90631E+00, 3.07165E+00, 9.86161E-01, 1.63536E+01,
         4.63830E+00, 1.00000E+00, 0.00000E+00, 0.00000E+00, 0.00000E+00,
@@ -423,12 +426,12 @@ double ModelSet::pdl[2][25] = {
 };
 
 /* LOWER BOUNDARY*/
-double ModelSet::ptm[10] = {
+inline const double ModelSet::ptm[10] = {
     1.04130E+03, 3.86000E+02, 1.95000E+02, 1.66728E+01, 2.13000E+02,
     1.20000E+02, 2.40000E+02, 1.87000E+02,-2.00000E+00, 0.00000E+00
 };
 
-double ModelSet::pdm[8][10] = {
+inline const double ModelSet::pdm[8][10] = {
     {
         2.45600E+07, 6.71072E-06, 1.00000E+02, 0.00000E+00, 1.10000E+02,
         1.00000E+01, 0.00000E+00, 0.00000E+00, 0.00000E+00, 0.00000E+00
@@ -463,7 +466,7 @@ double ModelSet::pdm[8][10] = {
     }
 };
 
-double ModelSet::ptl[4][100] = {
+inline const double ModelSet::ptl[4][100] = {
     /*TN1(2)*/
     {
         1.00858E+00, 4.56011E-02,-2.22972E-02,-5.44388E-02, 5.23136E-04,
@@ -558,7 +561,7 @@ double ModelSet::ptl[4][100] = {
     }
 };
 
-double ModelSet::pma[10][100] = {
+inline const double ModelSet::pma[10][100] = {
     /*TN2(2)*/
     {
         9.81637E-01,-1.41317E-03, 3.87323E-02, 0.00000E+00, 0.00000E+00,
@@ -800,7 +803,7 @@ double ModelSet::pma[10][100] = {
     }
 };
 /*SEMIANNUAL MULT SAM*/
-double ModelSet::sam[100] = {
+inline const double ModelSet::sam[100] = {
     1.00000E+00, 1.00000E+00, 1.00000E+00, 1.00000E+00, 1.00000E+00,
     1.00000E+00, 1.00000E+00, 1.00000E+00, 1.00000E+00, 1.00000E+00,
     1.00000E+00, 1.00000E+00, 1.00000E+00, 1.00000E+00, 1.00000E+00,
@@ -824,7 +827,7 @@ double ModelSet::sam[100] = {
 };
 
 /*MIDDLE ATMOSPHERE AVERAGES*/
-double ModelSet::pavgm[10] = {
+inline const double ModelSet::pavgm[10] = {
     2.61000E+02, 2.64000E+02, 2.29000E+02, 2.17000E+02, 2.17000E+02,
     2.23000E+02, 2.86760E+02,-2.93940E+00, 2.50000E+00, 0.00000E+00
 };
@@ -13,17 +13,616 @@
 
 #pragma once
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
 #include "AngleHelper.hpp"
 #include "Coordinate.hpp"
 #include "Essential.hpp"
 #include "GeoAtmosType.hpp"
 #include "Model.hpp"
 
+// globe7 / glob7s を同時に評価する地点数 (1 でベクトル化を無効化)
+#ifndef GEOATMOS_NRLMSISE_LANE_WIDTH
+#define GEOATMOS_NRLMSISE_LANE_WIDTH 4
+#endif
+
+// densu / densm / dnet などの exp, log, pow を多項式近似と乗算に置き換える (0 で無効)
+#ifndef GEOATMOS_NRLMSISE_FAST_MATH
+#define GEOATMOS_NRLMSISE_FAST_MATH 0
+#endif
+
+// NrlmsiseDual の偏微分のループを展開する (-O2 では展開されず偏微分がメモリに残るため)
+#if defined(__GNUC__)
+#define GEOATMOS_NRLMSISE_UNROLL _Pragma("GCC unroll 8")
+#else
+#define GEOATMOS_NRLMSISE_UNROLL
+#endif
+
 GEOATMOS_NAMESPACE_BEGIN
 
 namespace internal {
+	constexpr int nrlmsise_lane_width = GEOATMOS_NRLMSISE_LANE_WIDTH;
+	static_assert(nrlmsise_lane_width >= 1, "GEOATMOS_NRLMSISE_LANE_WIDTH must be positive.");
+	constexpr bool nrlmsise_fast_math = GEOATMOS_NRLMSISE_FAST_MATH != 0;
+
+	/**
+	 * @brief 引数の型を推論に使わない (S は ws などの他の引数から決める)
+	 *
+	 */
+	template <class S>
+	using NrlmsiseArg = std::type_identity_t<S>;
+
+	/**
+	 * @brief NRLMSISE-00 Atmosphere Model scratch state
+	 * @note 1回の評価中にだけ使う中間値. 呼び出し側がスレッド毎 (または呼び出し毎) に用意する
+	 *
+	 */
+	template <class S>
+	struct NrlmsiseWorkspaceT {
+		/* PARMB */
+		S gsurf;
+		S re;
+
+		/* DMIX */
+		S dm28;
+
+		/* MESO7 */
+		S meso_tn1[5];
+		S meso_tn2[4];
+		S meso_tn3[5];
+		S meso_tgn1[2];
+		S meso_tgn2[2];
+		S meso_tgn3[2];
+
+		/* Error handling */
+		bool nothrow;		  // true の場合は例外を投げずに status にフラグを立てて計算を続ける
+		std::uint32_t status; // EvaluationStatus::Flag の論理和
+	};
+
+	using NrlmsiseWorkspace = NrlmsiseWorkspaceT<double>;
+
+	/**
+	 * @brief gts7 のうち高度に依存しない中間値 (温度プロファイルと各成分の下端密度)
+	 * @note 高度が閾値 (ZA, zn1[4], 300 km) を跨ぐと値が変わるため, 高度帯ごとに用意する
+	 *
+	 */
+	template <class S>
+	struct NrlmsiseColumnT {
+		S tinf, tlb, s;
+		double xmm;
+		S meso_tn1[5] = {};
+		S meso_tgn1[2] = {};
+		S db28, db04, db16, db32, db40, db01, db14, db16h; // diffusive density at Zlb
+		S b28, b04, b16, b32, b40, b01, b14;			   // mixed density at Zlb
+		double zhm28;
+		S rl04, rl16, rl32, rl40, rl01, rl14; // mixing ratio corrections
+		S rc32;
+		double tho;
+		S zsho;
+	};
+
+	using NrlmsiseColumn = NrlmsiseColumnT<double>;
+
+	/**
+	 * @brief 高度だけが異なる入力の間で使い回す gts7 / gtd7 の中間値
+	 * @note 使い回す入力は sharesGlobeTerms() を満たすこと. 入力が変わったら reset() する
+	 *
+	 */
+	template <class S>
+	struct NrlmsiseColumnCacheT {
+		NrlmsiseColumnT<S> columns[8]; // Nrlmsise::columnRegime() ごと
+		bool has_column[8] = {};
+		NrlmsiseOutputT<S> mesopause; // gtd7 が zn2[0] で評価した gts7 の出力
+		S mesopause_dm28;
+		bool has_mesopause = false;
+
+		void reset() {
+			std::fill(std::begin(has_column), std::end(has_column), false);
+			has_mesopause = false;
+		}
+	};
+
+	using NrlmsiseColumnCache = NrlmsiseColumnCacheT<double>;
+
+	/**
+	 * @brief globe7 / glob7s の係数行ごとの評価値
+	 * @note 高度に依存しないため, 同じ時刻・地点であれば高度が異なっても共有できる
+	 *
+	 */
+	template <class T>
+	struct NrlmsiseGlobeTermsT {
+		T pt, ps;
+		T pd[9];
+		T ptl[4];
+		T pma[10];
+		bool has_ptl; // ptl, pma[8] を評価済み
+		bool has_pma; // pma[0-7, 9] を評価済み
+	};
+
+	using NrlmsiseGlobeTerms = NrlmsiseGlobeTermsT<double>;
+
+	/**
+	 * @brief 2つの入力が同じ球面調和展開を持つか (高度以外の入力が全て等しいか)
+	 *
+	 */
+	inline bool sharesGlobeTerms(const NrlmsiseInput &a, const NrlmsiseInput &b) {
+		if (a.doy != b.doy || a.sec != b.sec || a.g_lat != b.g_lat || a.g_long != b.g_long || a.lst != b.lst) return false;
+		if (a.f107A != b.f107A || a.f107 != b.f107 || a.ap != b.ap) return false;
+		return std::equal(std::begin(a.ap_a.a), std::end(a.ap_a.a), std::begin(b.ap_a.a));
+	}
+
+	/**
+	 * @brief 複数地点を同時に計算するためのレーン (1要素が1地点)
+	 *
+	 */
+	template <int W, class S = double>
+	using NrlmsiseLanes = Eigen::Array<S, W, 1>;
+
+	/**
+	 * @brief NRLMSISE-00 Atmosphere Model Input (Structure of Arrays)
+	 *
+	 */
+	template <int W, class S = double>
+	struct NrlmsiseInputLanes {
+		NrlmsiseLanes<W, S> doy;
+		NrlmsiseLanes<W, S> sec;
+		NrlmsiseLanes<W, S> alt;
+		NrlmsiseLanes<W, S> g_lat;
+		NrlmsiseLanes<W, S> g_long;
+		NrlmsiseLanes<W, S> lst;
+		NrlmsiseLanes<W, S> f107A;
+		NrlmsiseLanes<W, S> f107;
+		NrlmsiseLanes<W, S> ap;
+		struct {
+			NrlmsiseLanes<W, S> a[7];
+		} ap_a;
+
+		void set(int lane, const NrlmsiseInput &input) {
+			doy[lane] = input.doy;
+			sec[lane] = input.sec;
+			alt[lane] = input.alt;
+			g_lat[lane] = input.g_lat;
+			g_long[lane] = input.g_long;
+			lst[lane] = input.lst;
+			f107A[lane] = input.f107A;
+			f107[lane] = input.f107;
+			ap[lane] = input.ap;
+			for (int i = 0; i < 7; i++) ap_a.a[i][lane] = input.ap_a.a[i];
+		}
+	};
+
+	/**
+	 * @brief GEOATMOS_NRLMSISE_FAST_MATH で使う exp / log / pow の近似
+	 * @note テーブル参照と分岐を使わない多項式近似のため, ループ内では自動ベクトル化できる.
+	 *       誤差は exp が相対 5e-13 以内, log が max(1, |log x|) × 5e-14 以内 (CheckFastMath で確認).
+	 *       モデル自体の不確かさ (10% 程度) に比べて十分小さい
+	 *
+	 */
+	namespace fastmath {
+		constexpr double ln2_hi = 6.93147180369123816490e-01; // ln2 の上位ビット (k × ln2_hi が丸め誤差なしで求まる)
+		constexpr double ln2_lo = 1.90821492927058770002e-10; // ln2 - ln2_hi
+
+		/**
+		 * @brief exp(x)
+		 * @note x = k ln2 + r (|r| ≤ ln2 / 2) に分解し, exp(r) を10次の Taylor 展開で求める.
+		 *       x < -708 では 0 を返す (非正規化数は返さない)
+		 *
+		 */
+		inline double exp(double x) {
+			constexpr double log2e = 1.4426950408889634;
+			constexpr double shifter = 6755399441055744.0; // 1.5 × 2^52 (加算で最近接の整数に丸める)
+
+			const double xc = std::min(std::max(x, -708.0), 709.0);
+			const double ks = xc * log2e + shifter;
+			const double k = ks - shifter;
+			const double r = (xc - k * ln2_hi) - k * ln2_lo;
+
+			// Estrin 法で評価して依存関係の連鎖を短くする
+			const double r2 = r * r;
+			const double r4 = r2 * r2;
+			const double p01 = 1.0 + r;
+			const double p23 = 1.0 / 2 + r * (1.0 / 6);
+			const double p45 = 1.0 / 24 + r * (1.0 / 120);
+			const double p67 = 1.0 / 720 + r * (1.0 / 5040);
+			const double p89 = 1.0 / 40320 + r * (1.0 / 362880);
+			const double p = (p01 + r2 * p23) + r4 * ((p45 + r2 * p67) + r4 * (p89 + r2 * (1.0 / 3628800)));
+
+			// ks の仮数部の下位ビットは k そのもの
+			const double scale = std::bit_cast<double>((std::bit_cast<std::uint64_t>(ks) + 1023) << 52);
+			if (x < -708.0) return 0.0;
+			if (x > 709.0) return std::numeric_limits<double>::infinity();
+			return p * scale;
+		}
+
+		/**
+		 * @brief log(x)
+		 * @note x = 2^k m (√0.5 ≤ m < √2) に分解し, log(m) = 2 atanh((m - 1) / (m + 1)) を級数で求める.
+		 *       正規化数以外 (0, 負, 非正規化数, inf, NaN) は std::log に任せる
+		 *
+		 */
+		inline double log(double x) {
+			if (!(x >= std::numeric_limits<double>::min() && x <= std::numeric_limits<double>::max())) return std::log(x);
+
+			const std::uint64_t bits = std::bit_cast<std::uint64_t>(x);
+			const bool upper = (bits & 0x000fffffffffffffULL) > 0x0006a09e667f3bccULL; // m > √2
+			const double k = static_cast<double>(static_cast<std::int64_t>(bits >> 52) - 1023 + upper);
+			const std::uint64_t exponent = upper ? 0x3fe0000000000000ULL : 0x3ff0000000000000ULL;
+			const double m = std::bit_cast<double>((bits & 0x000fffffffffffffULL) | exponent);
+
+			const double s = (m - 1.0) / (m + 1.0);
+			const double z = s * s;
+			const double z2 = z * z;
+			const double p13 = 1.0 + z * (1.0 / 3);
+			const double p57 = 1.0 / 5 + z * (1.0 / 7);
+			const double p911 = 1.0 / 9 + z * (1.0 / 11);
+			const double p1315 = 1.0 / 13 + z * (1.0 / 15);
+			const double p = p13 + z2 * (p57 + z2 * (p911 + z2 * p1315));
+			return k * ln2_hi + (2.0 * s * p + k * ln2_lo);
+		}
+
+		/**
+		 * @brief pow(x, y) = exp(y log(x)) (x > 0)
+		 * @note x ≤ 0 などの特殊な場合は std::pow に任せる
+		 *
+		 */
+		inline double pow(double x, double y) {
+			if (!(x >= std::numeric_limits<double>::min() && x <= std::numeric_limits<double>::max())) return std::pow(x, y);
+			return exp(y * log(x));
+		}
+	} // namespace fastmath
+
+	/**
+	 * @brief 前進型自動微分の2重数 (値と N 個の独立変数についての偏微分)
+	 * @note 値は double と同じ演算で求めるため, double で計算した結果と一致する.
+	 *       比較は値だけで行うため, 分岐は評価点を含む側の式が微分される
+	 *
+	 */
+	template <int N>
+	struct NrlmsiseDual {
+		double v;	 // 値
+		double d[N]; // 各独立変数についての偏微分
+
+		NrlmsiseDual(double x = 0.0) : v(x), d{} {}
+
+		static NrlmsiseDual Constant(double x) { return NrlmsiseDual(x); }
+
+		/**
+		 * @brief i 番目の独立変数
+		 *
+		 */
+		static NrlmsiseDual variable(double x, int i) {
+			NrlmsiseDual r(x);
+			r.d[i] = 1.0;
+			return r;
+		}
+
+		double value() const { return v; }
+		double derivative(int i) const { return d[i]; }
+
+		/**
+		 * @brief 合成関数 f(this) (値 fv, 導関数の値 df)
+		 *
+		 */
+		NrlmsiseDual chain(double fv, double df) const {
+			NrlmsiseDual r(fv);
+			GEOATMOS_NRLMSISE_UNROLL for (int i = 0; i < N; i++) r.d[i] = d[i] * df;
+			return r;
+		}
+
+		NrlmsiseDual operator-() const { return chain(-v, -1.0); }
+
+		NrlmsiseDual &operator+=(const NrlmsiseDual &b) {
+			v += b.v;
+			GEOATMOS_NRLMSISE_UNROLL for (int i = 0; i < N; i++) d[i] += b.d[i];
+			return *this;
+		}
+
+		friend NrlmsiseDual operator+(NrlmsiseDual a, const NrlmsiseDual &b) { return a += b; }
+		friend NrlmsiseDual operator+(NrlmsiseDual a, double b) { return a.v += b, a; }
+		friend NrlmsiseDual operator+(double a, NrlmsiseDual b) { return b.v = a + b.v, b; }
+
+		friend NrlmsiseDual operator-(const NrlmsiseDual &a, const NrlmsiseDual &b) {
+			NrlmsiseDual r(a.v - b.v);
+			GEOATMOS_NRLMSISE_UNROLL for (int i = 0; i < N; i++) r.d[i] = a.d[i] - b.d[i];
+			return r;
+		}
+		friend NrlmsiseDual operator-(NrlmsiseDual a, double b) { return a.v -= b, a; }
+		friend NrlmsiseDual operator-(double a, const NrlmsiseDual &b) { return b.chain(a - b.v, -1.0); }
+
+		friend NrlmsiseDual operator*(const NrlmsiseDual &a, const NrlmsiseDual &b) {
+			NrlmsiseDual r(a.v * b.v);
+			GEOATMOS_NRLMSISE_UNROLL for (int i = 0; i < N; i++) r.d[i] = a.d[i] * b.v + a.v * b.d[i];
+			return r;
+		}
+		friend NrlmsiseDual operator*(const NrlmsiseDual &a, double b) { return a.chain(a.v * b, b); }
+		friend NrlmsiseDual operator*(double a, const NrlmsiseDual &b) { return b.chain(a * b.v, a); }
+
+		friend NrlmsiseDual operator/(const NrlmsiseDual &a, const NrlmsiseDual &b) {
+			NrlmsiseDual r(a.v / b.v);
+			const double inv = 1.0 / b.v;
+			GEOATMOS_NRLMSISE_UNROLL for (int i = 0; i < N; i++) r.d[i] = (a.d[i] - r.v * b.d[i]) * inv;
+			return r;
+		}
+		friend NrlmsiseDual operator/(const NrlmsiseDual &a, double b) { return a.chain(a.v / b, 1.0 / b); }
+		friend NrlmsiseDual operator/(double a, const NrlmsiseDual &b) {
+			const double r = a / b.v;
+			return b.chain(r, -r / b.v);
+		}
+
+		friend bool operator<(const NrlmsiseDual &a, const NrlmsiseDual &b) { return a.v < b.v; }
+		friend bool operator>(const NrlmsiseDual &a, const NrlmsiseDual &b) { return a.v > b.v; }
+		friend bool operator<=(const NrlmsiseDual &a, const NrlmsiseDual &b) { return a.v <= b.v; }
+		friend bool operator>=(const NrlmsiseDual &a, const NrlmsiseDual &b) { return a.v >= b.v; }
+		friend bool operator==(const NrlmsiseDual &a, const NrlmsiseDual &b) { return a.v == b.v; }
+		friend bool operator<(const NrlmsiseDual &a, double b) { return a.v < b; }
+		friend bool operator>(const NrlmsiseDual &a, double b) { return a.v > b; }
+		friend bool operator<=(const NrlmsiseDual &a, double b) { return a.v <= b; }
+		friend bool operator>=(const NrlmsiseDual &a, double b) { return a.v >= b; }
+		friend bool operator==(const NrlmsiseDual &a, double b) { return a.v == b; }
+	};
+
+	/**
+	 * @brief double (1地点) と NrlmsiseLanes (複数地点) に共通の数学関数
+	 * @note GEOATMOS_NRLMSISE_FAST_MATH が有効な場合, double の exp / log / pow は fastmath の近似を使い,
+	 *       ipow は乗算の連鎖になる
+	 *
+	 */
+	namespace lane {
+		inline double sin(double x) { return std::sin(x); }
+		inline double cos(double x) { return std::cos(x); }
+		inline double sqrt(double x) { return std::sqrt(x); }
+		inline double min(double x, double y) { return std::min(x, y); }
+
+		inline double exp(double x) {
+			if constexpr (nrlmsise_fast_math) {
+				return fastmath::exp(x);
+			} else {
+				return std::exp(x);
+			}
+		}
+
+		inline double log(double x) {
+			if constexpr (nrlmsise_fast_math) {
+				return fastmath::log(x);
+			} else {
+				return std::log(x);
+			}
+		}
+
+		inline double pow(double x, double y) {
+			if constexpr (nrlmsise_fast_math) {
+				return fastmath::pow(x, y);
+			} else {
+				return std::pow(x, y);
+			}
+		}
+
+		template <class D>
+		auto sin(const Eigen::ArrayBase<D> &x) -> typename D::PlainObject {
+			return x.sin();
+		}
+
+		template <class D>
+		auto cos(const Eigen::ArrayBase<D> &x) -> typename D::PlainObject {
+			return x.cos();
+		}
+
+		template <class D>
+		auto exp(const Eigen::ArrayBase<D> &x) -> typename D::PlainObject {
+			return x.exp();
+		}
+
+		template <class D>
+		auto sqrt(const Eigen::ArrayBase<D> &x) -> typename D::PlainObject {
+			return x.sqrt();
+		}
+
+		template <class D>
+		auto pow(const Eigen::ArrayBase<D> &x, double y) -> typename D::PlainObject {
+			return x.pow(static_cast<typename D::Scalar>(y));
+		}
+
+		template <class D>
+		auto min(const Eigen::ArrayBase<D> &x, double y) -> typename D::PlainObject {
+			return x.min(y);
+		}
+
+		template <int N>
+		NrlmsiseDual<N> sin(const NrlmsiseDual<N> &x) {
+			return x.chain(std::sin(x.value()), std::cos(x.value()));
+		}
+
+		template <int N>
+		NrlmsiseDual<N> cos(const NrlmsiseDual<N> &x) {
+			return x.chain(std::cos(x.value()), -std::sin(x.value()));
+		}
+
+		/**
+		 * @brief √x
+		 * @note カーネルでは √(x^2) を |x| として使うため, x = 0 での微分は 0 とする
+		 *
+		 */
+		template <int N>
+		NrlmsiseDual<N> sqrt(const NrlmsiseDual<N> &x) {
+			const double r = std::sqrt(x.value());
+			return x.chain(r, (r > 0) ? 0.5 / r : 0.0);
+		}
+
+		template <int N>
+		NrlmsiseDual<N> exp(const NrlmsiseDual<N> &x) {
+			const double r = lane::exp(x.value());
+			return x.chain(r, r);
+		}
+
+		template <int N>
+		NrlmsiseDual<N> log(const NrlmsiseDual<N> &x) {
+			return x.chain(lane::log(x.value()), 1.0 / x.value());
+		}
+
+		template <int N>
+		NrlmsiseDual<N> pow(const NrlmsiseDual<N> &x, double y) {
+			const double r = lane::pow(x.value(), y);
+			return x.chain(r, (x.value() != 0) ? y * r / x.value() : y * lane::pow(x.value(), y - 1.0));
+		}
+
+		/**
+		 * @brief x^y (x > 0)
+		 *
+		 */
+		template <int N>
+		NrlmsiseDual<N> pow(const NrlmsiseDual<N> &x, const NrlmsiseDual<N> &y) {
+			const double r = lane::pow(x.value(), y.value());
+			const double dx = y.value() * r / x.value(), dy = r * lane::log(x.value());
+			NrlmsiseDual<N> p(r);
+			GEOATMOS_NRLMSISE_UNROLL for (int i = 0; i < N; i++) p.d[i] = dx * x.d[i] + dy * y.d[i];
+			return p;
+		}
+
+		template <int N>
+		NrlmsiseDual<N> min(const NrlmsiseDual<N> &x, double y) {
+			return (y < x.value()) ? NrlmsiseDual<N>(y) : x;
+		}
+
+		template <class T>
+		T mask(bool x) {
+			return x ? 1.0 : 0.0;
+		}
+
+		template <class T, class D>
+		T mask(const Eigen::ArrayBase<D> &x) {
+			return x.template cast<typename T::Scalar>();
+		}
+
+		template <class T>
+		T constant(double x) {
+			if constexpr (std::is_arithmetic_v<T>) {
+				return x;
+			} else {
+				return T::Constant(x);
+			}
+		}
+
+		/**
+		 * @brief x の N 乗 (N は正の整数)
+		 *
+		 */
+		template <int N, class T>
+		T ipow(const T &x) {
+			static_assert(N >= 1, "N must be positive.");
+			if constexpr (!nrlmsise_fast_math) {
+				return lane::pow(x, static_cast<double>(N));
+			} else if constexpr (N == 1) {
+				return x;
+			} else if constexpr (N % 2 == 0) {
+				const T h = ipow<N / 2>(x);
+				return h * h;
+			} else {
+				return x * ipow<N - 1>(x);
+			}
+		}
+	} // namespace lane
+
+	/**
+	 * @brief 位置によらない値の型 (NrlmsiseDual では偏微分が常に 0 のため double, それ以外は T)
+	 *
+	 */
+	template <class T>
+	struct NrlmsiseConstantOf {
+		using type = T;
+	};
+
+	template <int N>
+	struct NrlmsiseConstantOf<NrlmsiseDual<N>> {
+		using type = double;
+	};
+
+	template <class T>
+	using NrlmsiseConstant = typename NrlmsiseConstantOf<T>::type;
+
+	/**
+	 * @brief globe7 / glob7s の基底 (係数行に依存しない入力由来の値)
+	 * @note 1地点につき1回だけ計算し, 全ての係数行の評価で共有する.
+	 *       T は double (1地点), NrlmsiseLanes (複数地点) または NrlmsiseDual (偏微分)
+	 *
+	 */
+	template <class T>
+	struct NrlmsiseBasis {
+		using C = NrlmsiseConstant<T>;
+
+		T plg[4][9];		  // ルジャンドル陪関数
+		T ctloc, stloc;		  // 地方時の調和関数
+		T c2tloc, s2tloc;
+		T s3tloc, c3tloc;
+		C cdoy, sdoy;		  // 通日の調和関数
+		C c2doy, s2doy;
+		T clong, slong;		  // 経度の調和関数
+		C cut, sut;			  // 世界時の調和関数
+		T cut2long, sut2long; // 世界時 + 2 × 経度 の調和関数
+		C has_long;			  // 経度依存項を含める場合は 1, 含めない場合は 0
+		T abs_lat;			  // 緯度の絶対値 [deg]
+		C df, dfa;			  // F10.7 の偏差
+		C apd;				  // 日平均 Ap - 4
+		C ap[7];			  // 3時間毎の Ap 履歴
+	};
+
+	/**
+	 * @brief 係数行に含まれる位相 (通日・地方時・経度・世界時) の cos / sin
+	 *
+	 */
+	struct NrlmsisePhase {
+		double c, s;
+	};
+
+	/**
+	 * @brief 1つの係数行が参照する位相
+	 * @note cos(x - 位相) を基底の cos(x), sin(x) との積和で求めるために使う
+	 *
+	 */
+	struct NrlmsiseRowPhases {
+		NrlmsisePhase doy13, doy17, doy31, doy38, doy81, doy84, doy86, doy88;
+		NrlmsisePhase hour124, hour131;
+		NrlmsisePhase deg63, deg97, deg118, deg136;
+		NrlmsisePhase ut58, ut71, ut75, ut79;
+	};
+
+	/**
+	 * @brief 全係数行の位相 (係数は定数のため初回参照時に1度だけ計算する)
+	 *
+	 */
+	struct NrlmsisePhaseTable {
+		NrlmsiseRowPhases pt, ps;
+		NrlmsiseRowPhases pd[9];
+		NrlmsiseRowPhases ptl[4];
+		NrlmsiseRowPhases pma[10];
+	};
+
+	/**
+	 * @brief globe7 が後続の glob7s に引き継ぐ磁気活動項
+	 *
+	 */
+	template <class T>
+	struct NrlmsiseApContext {
+		NrlmsiseConstant<T> apdf;
+		T apt;
+	};
+
+	/**
+	 * @brief cos(x - 位相)
+	 *
+	 */
+	template <class T>
+	T shifted(const T &cx, const T &sx, const NrlmsisePhase &phase) {
+		return cx * phase.c + sx * phase.s;
+	}
+
 	/**
 	 * @brief NRLMSISE-00 Atmosphere Model
+	 * @note 内部状態を持たないため, 1つのインスタンスを複数スレッドから同時に使用できる.
+	 *       計算中にヒープ確保は行わない (作業領域はすべて固定長配列)
 	 *
 	 */
 	class Nrlmsise : public ModelSet {
@@ -31,81 +630,118 @@ namespace internal {
 		Nrlmsise();
 
 	  private:
-		/* PARMB */
-		double gsurf;
-		double re;
-
-		/* GTS3C */
-		double dd;
+		template <class S>
+		void glatf(NrlmsiseArg<S> lat, S &gv, S &reff) const;
+		template <class S>
+		S ccor(S alt, NrlmsiseArg<S> r, double h1, double zh) const;
+		template <class S>
+		S ccor2(S alt, NrlmsiseArg<S> r, double h1, double zh, double h2) const;
+		template <class S>
+		S scalh(double alt, double xm, double temp, const NrlmsiseWorkspaceT<S> &ws) const;
+		template <class S>
+		void fail(NrlmsiseWorkspaceT<S> &ws, std::uint32_t flag, const char *message) const;
+		template <class S>
+		S dnet(NrlmsiseArg<S> dd, NrlmsiseArg<S> dm, double zhm, double xmm, double xm, NrlmsiseWorkspaceT<S> &ws) const;
+		template <class S>
+		void splini(const S *xa, const S *ya, const S *y2a, int n, NrlmsiseArg<S> x, S &y) const;
+		template <class S>
+		void splint(const S *xa, const S *ya, const S *y2a, int n, NrlmsiseArg<S> x, S &y, NrlmsiseWorkspaceT<S> &ws) const;
+		template <class S>
+		void spline(const S *x, const S *y, int n, NrlmsiseArg<S> yp1, NrlmsiseArg<S> ypn, S *y2) const;
+		template <class S>
+		S densm(NrlmsiseArg<S> alt, NrlmsiseArg<S> d0, double xm, S &tz, int mn3, const double *zn3, const S *tn3, const S *tgn3, int mn2,
+				const double *zn2, const S *tn2, const S *tgn2, NrlmsiseWorkspaceT<S> &ws) const;
+		template <class S>
+		S densu(NrlmsiseArg<S> alt, NrlmsiseArg<S> dlb, NrlmsiseArg<S> tinf, NrlmsiseArg<S> tlb, double xm, double alpha, S &tz, double zlb,
+				NrlmsiseArg<S> s2, int mn1, const double *zn1, S *tn1, S *tgn1, NrlmsiseWorkspaceT<S> &ws) const;
+		static NrlmsiseRowPhases rowPhases(const double *p, int n);
+		static const NrlmsisePhaseTable &phaseTable();
+		template <class T, class Input, class Flags>
+		void globeBasis(const Input &input, const Flags &flags, NrlmsiseBasis<T> &b) const;
+		template <class T, class Flags>
+		T globe7(const double *p, const NrlmsiseRowPhases &ph, const NrlmsiseBasis<T> &b, const Flags &flags,
+				 NrlmsiseApContext<T> &ctx) const;
+		template <class T, class Flags>
+		T glob7s(const double *p, const NrlmsiseRowPhases &ph, const NrlmsiseBasis<T> &b, const Flags &flags,
+				 const NrlmsiseApContext<T> &ctx) const;
+		template <class T, class Flags>
+		void globeRows(const NrlmsiseBasis<T> &b, const Flags &flags, NrlmsiseGlobeTermsT<T> &terms) const;
+		template <class Flags>
+		void gtd7d(const NrlmsiseInput &input, const Flags &flags, NrlmsiseOutput &output, NrlmsiseWorkspace &ws) const;
+		template <class Flags>
+		void ghp7(NrlmsiseInput &input, const Flags &flags, NrlmsiseOutput &output, double press, NrlmsiseWorkspace &ws) const;
+		template <class S, class Flags>
+		void gts7(const NrlmsiseInputT<S> &input, const Flags &flags, const NrlmsiseGlobeTermsT<S> &terms, NrlmsiseOutputT<S> &output,
+				  NrlmsiseWorkspaceT<S> &ws, NrlmsiseColumnCacheT<S> *cache = nullptr) const;
+		template <class S, class Flags>
+		void gts7Column(const NrlmsiseInputT<S> &input, const Flags &flags, const NrlmsiseGlobeTermsT<S> &terms,
+						NrlmsiseColumnT<S> &column, NrlmsiseWorkspaceT<S> &ws) const;
+		template <class S, class Flags>
+		void gts7Level(const NrlmsiseInputT<S> &input, const Flags &flags, const NrlmsiseColumnT<S> &column, NrlmsiseOutputT<S> &output,
+					   NrlmsiseWorkspaceT<S> &ws) const;
+		template <class S>
+		static int columnRegime(const S &alt);
+
+		template <class S>
+		S zeta(NrlmsiseArg<S> zz, double zl, const NrlmsiseWorkspaceT<S> &ws) const {
+			return ((zz - zl) * (ws.re + zl) / (ws.re + zz));
+		}
 
-		/* DMIX */
-		double dm04, dm16, dm28, dm32, dm40, dm01, dm14;
+		template <class T>
+		T g0(const T &a, const double *p, double p24) const {
+			return (a - 4.0 + (p[25] - 1.0) * (a - 4.0 + (lane::exp(-std::fabs(p24) * (a - 4.0)) - 1.0) / std::fabs(p24)));
+		}
 
-		/* MESO7 */
-		double meso_tn1[5];
-		double meso_tn2[4];
-		double meso_tn3[5];
-		double meso_tgn1[2];
-		double meso_tgn2[2];
-		double meso_tgn3[2];
-
-		/* LPOLY */
-		double dfa;
-		double plg[4][9];
-		double ctloc, stloc;
-		double c2tloc, s2tloc;
-		double s3tloc, c3tloc;
-		double apdf, apt[4];
-
-		static double zn1[5];
-		static double zn2[4];
-		static double zn3[5];
-		static double alpha[9];
-		static double altl[8];
+		template <class T>
+		T sumex(const T &ex) const {
+			return (1.0 + (1.0 - lane::ipow<19>(ex)) / (1.0 - ex) * lane::sqrt(ex));
+		}
 
-	  private:
-		void tselec(NrlmsiseConfig &flags);
-		void glatf(double lat, double &gv, double &reff);
-		double ccor(double alt, double r, double h1, double zh);
-		double ccor2(double alt, double r, double h1, double zh, double h2);
-		double scalh(double alt, double xm, double temp);
-		double dnet(double dd, double dm, double zhm, double xmm, double xm);
-		void splini(double *xa, double *ya, double *y2a, int n, double x, double &y);
-		void splint(double *xa, double *ya, double *y2a, int n, double x, double &y);
-		void spline(double *x, double *y, int n, double yp1, double ypn, double *y2);
-		double densm(double alt, double d0, double xm, double &tz, int mn3, double *zn3, double *tn3, double *tgn3, int mn2, double *zn2,
-					 double *tn2, double *tgn2);
-		double densu(double alt, double dlb, double tinf, double tlb, double xm, double alpha, double &tz, double zlb, double s2, int mn1,
-					 double *zn1, double *tn1, double *tgn1);
-		double globe7(double *p, NrlmsiseInput &input, NrlmsiseConfig &flags);
-		double glob7s(double *p, NrlmsiseInput &input, NrlmsiseConfig &flags);
-		void gtd7d(NrlmsiseInput &input, NrlmsiseConfig &flags, NrlmsiseOutput &output);
-		void ghp7(NrlmsiseInput &input, NrlmsiseConfig &flags, NrlmsiseOutput &output, double press);
-		void gts7(NrlmsiseInput &input, NrlmsiseConfig &flags, NrlmsiseOutput &output);
-
-		double zeta(double zz, double zl) { return ((zz - zl) * (re + zl) / (re + zz)); }
-
-		double g0(double a, const double *p) {
-			return (a - 4.0 +
-					(p[25] - 1.0) * (a - 4.0 + (std::exp(-std::sqrt(p[24] * p[24]) * (a - 4.0)) - 1.0) / std::sqrt(p[24] * p[24])));
-		}
-
-		double sumex(double ex) { return (1.0 + (1.0 - std::pow(ex, 19.0)) / (1.0 - ex) * std::pow(ex, 0.5)); }
-
-		double sg0(double ex, const double *p, double *ap) {
-			return (g0(ap[1], p) +
-					(g0(ap[2], p) * ex + g0(ap[3], p) * ex * ex + g0(ap[4], p) * std::pow(ex, 3.0) +
-					 (g0(ap[5], p) * std::pow(ex, 4.0) + g0(ap[6], p) * std::pow(ex, 12.0)) * (1.0 - std::pow(ex, 8.0)) / (1.0 - ex))) /
+		template <class T, class A>
+		T sg0(const T &ex, const double *p, double p24, const A *ap) const {
+			return (g0(ap[1], p, p24) +
+					(g0(ap[2], p, p24) * ex + g0(ap[3], p, p24) * ex * ex + g0(ap[4], p, p24) * lane::ipow<3>(ex) +
+					 (g0(ap[5], p, p24) * lane::ipow<4>(ex) + g0(ap[6], p, p24) * lane::ipow<12>(ex)) * (1.0 - lane::ipow<8>(ex)) /
+					   (1.0 - ex))) /
 				   sumex(ex);
 		}
 
 	  protected:
-		void gtd7(NrlmsiseInput &input, NrlmsiseConfig &flags, NrlmsiseOutput &output);
+		static constexpr double ptl_altitude_limit = 300.0;	// ptl, pma[8] を使う高度の上限 [km]
+		static constexpr double pma_altitude_limit = 72.5;	// pma[0-7, 9] を使う高度の上限 [km]
+		static constexpr int spline_max_nodes = 10;			// spline() に渡す節点数の上限 (densu, densm の節点配列の大きさ)
+
+		static constexpr void tselec(NrlmsiseConfig &flags);
+
+		/**
+		 * @brief コンパイル時に固定したスイッチ
+		 * @note NrlmsiseConfig と同じ名前で sw, swc を参照できるため, flags としてそのまま渡せる.
+		 *       スイッチが定数になるので, 無効な項の計算と sw, swc の乗算は最適化で取り除かれる
+		 *
+		 */
+		template <ModelConfig Config>
+		struct StaticConfig {
+			static constexpr NrlmsiseConfig native = [] {
+				auto flags = Config.convertNativeStatus();
+				tselec(flags);
+				return flags;
+			}();
+			static constexpr const double (&sw)[24] = native.sw;
+			static constexpr const double (&swc)[24] = native.swc;
+		};
+
+		template <class S, class Flags>
+		void globeTerms(const NrlmsiseInputT<S> &input, const Flags &flags, NrlmsiseGlobeTermsT<S> &terms) const;
+		template <int W, class S, class Flags>
+		void globeTermsLanes(const NrlmsiseInputLanes<W, S> &input, const Flags &flags, NrlmsiseGlobeTerms *terms) const;
+		template <class S, class Flags>
+		void gtd7(const NrlmsiseInputT<S> &input, const Flags &flags, NrlmsiseOutputT<S> &output, NrlmsiseWorkspaceT<S> &ws,
+				  const NrlmsiseArg<NrlmsiseGlobeTermsT<S>> *terms = nullptr, NrlmsiseArg<NrlmsiseColumnCacheT<S>> *cache = nullptr) const;
 	};
 
-	Nrlmsise::Nrlmsise() {}
+	inline Nrlmsise::Nrlmsise() {}
 
-	void Nrlmsise::tselec(NrlmsiseConfig &flags) {
+	constexpr void Nrlmsise::tselec(NrlmsiseConfig &flags) {
 		for (int i = 0; i < 24; i++) {
 			if (i != 9) {
 				if (flags.switches[i] == 1)
@@ -124,67 +760,79 @@ namespace internal {
 		}
 	}
 
-	void Nrlmsise::glatf(double lat, double &gv, double &reff) {
-		const double c2 = std::cos(2.0 * AngleHelper::degreeToRadian(lat));
+	template <class S>
+	void Nrlmsise::glatf(NrlmsiseArg<S> lat, S &gv, S &reff) const {
+		const S c2 = lane::cos(2.0 * (lat * constant::pi / 180.0));
 		gv = 980.616 * (1.0 - 0.0026373 * c2);
 		reff = 2.0 * (gv) / (3.085462E-6 + 2.27E-9 * c2) * 1.0E-5;
 	}
 
-	double Nrlmsise::ccor(double alt, double r, double h1, double zh) {
-		const double e = (alt - zh) / h1;
+	template <class S>
+	S Nrlmsise::ccor(S alt, NrlmsiseArg<S> r, double h1, double zh) const {
+		const S e = (alt - zh) / h1;
 		if (e > 70) return std::exp(0);
-		if (e < -70) return std::exp(r);
-		return std::exp(r / (1.0 + std::exp(e)));
+		if (e < -70) return lane::exp(r);
+		return lane::exp(r / (1.0 + lane::exp(e)));
 	}
 
-	double Nrlmsise::ccor2(double alt, double r, double h1, double zh, double h2) {
+	template <class S>
+	S Nrlmsise::ccor2(S alt, NrlmsiseArg<S> r, double h1, double zh, double h2) const {
 
-		const double e1 = (alt - zh) / h1;
-		const double e2 = (alt - zh) / h2;
+		const S e1 = (alt - zh) / h1;
+		const S e2 = (alt - zh) / h2;
 
 		if ((e1 > 70) || (e2 > 70)) return std::exp(0);
-		if ((e1 < -70) && (e2 < -70)) return std::exp(r);
+		if ((e1 < -70) && (e2 < -70)) return lane::exp(r);
 
-		const double ccor2v = r / (1.0 + 0.5 * (std::exp(e1) + std::exp(e2)));
-		return exp(ccor2v);
+		const S ccor2v = r / (1.0 + 0.5 * (lane::exp(e1) + lane::exp(e2)));
+		return lane::exp(ccor2v);
 	}
 
-	double Nrlmsise::scalh(double alt, double xm, double temp) {
+	template <class S>
+	S Nrlmsise::scalh(double alt, double xm, double temp, const NrlmsiseWorkspaceT<S> &ws) const {
 		constexpr double rgas = 831.4;
-		double g = gsurf / (std::pow((1.0 + alt / re), 2.0));
+		S g = ws.gsurf / (lane::ipow<2>(1.0 + alt / ws.re));
 		return rgas * temp / (g * xm);
 	}
 
-	double Nrlmsise::dnet(double dd, double dm, double zhm, double xmm, double xm) {
+	template <class S>
+	void Nrlmsise::fail(NrlmsiseWorkspaceT<S> &ws, std::uint32_t flag, const char *message) const {
+		if (!ws.nothrow) throw AtmosModelException(message, AtmosModelException::MathmaticalError);
+		ws.status |= flag;
+	}
+
+	template <class S>
+	S Nrlmsise::dnet(NrlmsiseArg<S> dd, NrlmsiseArg<S> dm, double zhm, double xmm, double xm, NrlmsiseWorkspaceT<S> &ws) const {
 
 		if (!((dm > 0) && (dd > 0))) {
-			throw AtmosModelException("Argument x of function log(x) is 0 or negative", AtmosModelException::MathmaticalError);
+			fail(ws, EvaluationStatus::MathDomainError, "Argument x of function log(x) is 0 or negative");
 			if ((dd == 0) && (dm == 0)) dd = 1;
 			if (dm == 0) return dd;
 			if (dd == 0) return dm;
 		}
 
-		double a = zhm / (xmm - xm);
-		double ylog = a * std::log(dm / dd);
+		const double a = zhm / (xmm - xm);
+		const S ylog = a * lane::log(dm / dd);
 		if (ylog < -10) return dd;
 		if (ylog > 10) return dm;
-		a = dd * std::pow((1.0 + std::exp(ylog)), (1.0 / a));
-		return a;
+		return dd * lane::pow(1.0 + lane::exp(ylog), 1.0 / a);
 	}
 
-	void Nrlmsise::splini(double *xa, double *ya, double *y2a, int n, double x, double &y) {
-		double yi = 0;
+	template <class S>
+	void Nrlmsise::splini(const S *xa, const S *ya, const S *y2a, int n, NrlmsiseArg<S> x, S &y) const {
+		S yi = 0;
 
 		int klo = 0;
 		int khi = 1;
 
-		double xx, h, a, b, a2, b2;
+		S xx, h, a, b, a2, b2;
 
-		while ((x > xa[klo]) && (khi < n)) {
+		/* x == xa[0] enters the first (zero width) interval and x == xa[khi] takes x, so that NrlmsiseDual keeps d/dx at the nodes */
+		while ((x > xa[klo] || (klo == 0 && x == xa[klo])) && (khi < n)) {
 			xx = x;
 
 			if (khi < (n - 1)) {
-				xx = (x < xa[khi]) ? x : xa[khi];
+				xx = (x <= xa[khi]) ? x : xa[khi];
 			}
 
 			h = xa[khi] - xa[klo];
@@ -202,7 +850,8 @@ namespace internal {
 		y = yi;
 	}
 
-	void Nrlmsise::splint(double *xa, double *ya, double *y2a, int n, double x, double &y) {
+	template <class S>
+	void Nrlmsise::splint(const S *xa, const S *ya, const S *y2a, int n, NrlmsiseArg<S> x, S &y, NrlmsiseWorkspaceT<S> &ws) const {
 		int klo = 0;
 		int khi = n - 1;
 		int k;
@@ -216,20 +865,25 @@ namespace internal {
 			}
 		}
 
-		double h = xa[khi] - xa[klo];
-		if (h == 0.0) throw AtmosModelException("Interpolation step is invalid.", AtmosModelException::MathmaticalError);
+		const S h = xa[khi] - xa[klo];
+		if (h == 0.0) {
+			fail(ws, EvaluationStatus::MathDomainError, "Interpolation step is invalid.");
+			y = std::numeric_limits<double>::quiet_NaN();
+			return;
+		}
 
-		double a = (xa[khi] - x) / h;
-		double b = (x - xa[klo]) / h;
-		double yi = a * ya[klo] + b * ya[khi] + ((a * a * a - a) * y2a[klo] + (b * b * b - b) * y2a[khi]) * h * h / 6.0;
+		const S a = (xa[khi] - x) / h;
+		const S b = (x - xa[klo]) / h;
+		const S yi = a * ya[klo] + b * ya[khi] + ((a * a * a - a) * y2a[klo] + (b * b * b - b) * y2a[khi]) * h * h / 6.0;
 
 		y = yi;
 	}
 
-	void Nrlmsise::spline(double *x, double *y, int n, double yp1, double ypn, double *y2) {
-		std::vector<double> u(n);
+	template <class S>
+	void Nrlmsise::spline(const S *x, const S *y, int n, NrlmsiseArg<S> yp1, NrlmsiseArg<S> ypn, S *y2) const {
+		S u[spline_max_nodes];
 
-		double sig, p, qn, un;
+		S sig, p, qn, un;
 
 		if (yp1 > 0.99E30) {
 			y2[0] = 0;
@@ -261,18 +915,20 @@ namespace internal {
 		for (int k = n - 2; k >= 0; k--) y2[k] = y2[k] * y2[k + 1] + u[k];
 	}
 
-	double Nrlmsise::densm(double alt, double d0, double xm, double &tz, int mn3, double *zn3, double *tn3, double *tgn3, int mn2,
-						   double *zn2, double *tn2, double *tgn2) {
+	template <class S>
+	S Nrlmsise::densm(NrlmsiseArg<S> alt, NrlmsiseArg<S> d0, double xm, S &tz, int mn3, const double *zn3, const S *tn3, const S *tgn3,
+					  int mn2, const double *zn2, const S *tn2, const S *tgn2, NrlmsiseWorkspaceT<S> &ws) const {
 
 		/*      Calculate Temperature and Density Profiles for lower atmos.  */
 
-		double xs[10], ys[10], y2out[10];
+		S xs[10], ys[10], y2out[10];
 		constexpr double rgas = 831.4;
-		double z, z1, z2, t1, t2, zg, zgdif;
-		double yd1, yd2;
-		double x, y, yi;
-		double expl, gamm, glb;
-		double densm_tmp;
+		double z1, z2;
+		S z, t1, t2, zg, zgdif;
+		S yd1, yd2;
+		S x, y, yi;
+		S expl, gamm, glb;
+		S densm_tmp;
 		int mn;
 
 		densm_tmp = d0;
@@ -291,28 +947,28 @@ namespace internal {
 		z2 = zn2[mn - 1];
 		t1 = tn2[0];
 		t2 = tn2[mn - 1];
-		zg = zeta(z, z1);
-		zgdif = zeta(z2, z1);
+		zg = zeta(z, z1, ws);
+		zgdif = zeta(z2, z1, ws);
 
 		/* set up spline nodes */
 		for (int k = 0; k < mn; k++) {
-			xs[k] = zeta(zn2[k], z1) / zgdif;
+			xs[k] = zeta(zn2[k], z1, ws) / zgdif;
 			ys[k] = 1.0 / tn2[k];
 		}
 
 		yd1 = -tgn2[0] / (t1 * t1) * zgdif;
-		yd2 = -tgn2[1] / (t2 * t2) * zgdif * (std::pow(((re + z2) / (re + z1)), 2.0));
+		yd2 = -tgn2[1] / (t2 * t2) * zgdif * (lane::ipow<2>((ws.re + z2) / (ws.re + z1)));
 
 		/* calculate spline coefficients */
 		spline(xs, ys, mn, yd1, yd2, y2out);
 		x = zg / zgdif;
-		splint(xs, ys, y2out, mn, x, y);
+		splint(xs, ys, y2out, mn, x, y, ws);
 
 		/* temperature at altitude */
 		tz = 1.0 / y;
 		if (xm != 0.0) {
 			/* calculate stratosphere / mesosphere density */
-			glb = gsurf / (std::pow((1.0 + z1 / re), 2.0));
+			glb = ws.gsurf / (lane::ipow<2>(1.0 + z1 / ws.re));
 			gamm = xm * glb * zgdif / rgas;
 
 			/* Integrate temperature profile */
@@ -321,7 +977,7 @@ namespace internal {
 			if (expl > 50.0) expl = 50.0;
 
 			/* Density at altitude */
-			densm_tmp = densm_tmp * (t1 / tz) * std::exp(-expl);
+			densm_tmp = densm_tmp * (t1 / tz) * lane::exp(-expl);
 		}
 
 		if (alt > zn3[0]) {
@@ -339,28 +995,28 @@ namespace internal {
 		z2 = zn3[mn - 1];
 		t1 = tn3[0];
 		t2 = tn3[mn - 1];
-		zg = zeta(z, z1);
-		zgdif = zeta(z2, z1);
+		zg = zeta(z, z1, ws);
+		zgdif = zeta(z2, z1, ws);
 
 		/* set up spline nodes */
 		for (int k = 0; k < mn; k++) {
-			xs[k] = zeta(zn3[k], z1) / zgdif;
+			xs[k] = zeta(zn3[k], z1, ws) / zgdif;
 			ys[k] = 1.0 / tn3[k];
 		}
 
 		yd1 = -tgn3[0] / (t1 * t1) * zgdif;
-		yd2 = -tgn3[1] / (t2 * t2) * zgdif * (std::pow(((re + z2) / (re + z1)), 2.0));
+		yd2 = -tgn3[1] / (t2 * t2) * zgdif * (lane::ipow<2>((ws.re + z2) / (ws.re + z1)));
 
 		/* calculate spline coefficients */
 		spline(xs, ys, mn, yd1, yd2, y2out);
 		x = zg / zgdif;
-		splint(xs, ys, y2out, mn, x, y);
+		splint(xs, ys, y2out, mn, x, y, ws);
 
 		/* temperature at altitude */
 		tz = 1.0 / y;
 		if (xm != 0.0) {
 			/* calaculate tropospheric / stratosphere density */
-			glb = gsurf / (std::pow((1.0 + z1 / re), 2.0));
+			glb = ws.gsurf / (lane::ipow<2>(1.0 + z1 / ws.re));
 			gamm = xm * glb * zgdif / rgas;
 
 			/* Integrate temperature profile */
@@ -369,7 +1025,7 @@ namespace internal {
 			if (expl > 50.0) expl = 50.0;
 
 			/* Density at altitude */
-			densm_tmp = densm_tmp * (t1 / tz) * std::exp(-expl);
+			densm_tmp = densm_tmp * (t1 / tz) * lane::exp(-expl);
 		}
 
 		if (xm == 0.0)
@@ -378,40 +1034,42 @@ namespace internal {
 			return densm_tmp;
 	}
 
-	double Nrlmsise::densu(double alt, double dlb, double tinf, double tlb, double xm, double alpha, double &tz, double zlb, double s2,
-						   int mn1, double *zn1, double *tn1, double *tgn1) {
+	template <class S>
+	S Nrlmsise::densu(NrlmsiseArg<S> alt, NrlmsiseArg<S> dlb, NrlmsiseArg<S> tinf, NrlmsiseArg<S> tlb, double xm, double alpha, S &tz,
+					  double zlb, NrlmsiseArg<S> s2, int mn1, const double *zn1, S *tn1, S *tgn1, NrlmsiseWorkspaceT<S> &ws) const {
 		constexpr double rgas = 831.4;
-		double yd2, yd1, x, y;
-		double densu_temp = 1.0;
-		double za, z, zg2, tt, ta;
-		double dta, z1, z2, t1, t2, zg, zgdif;
-		int mn;
-		double glb;
-		double expl;
-		double yi;
-		double densa;
-		double gamma, gamm;
-		double xs[5], ys[5], y2out[5];
+		S yd2, yd1, x, y;
+		S densu_temp = 1.0;
+		double za, z1 = 0, z2 = 0;
+		S z, zg2, tt, ta;
+		S dta, t1, t2, zg, zgdif;
+		int mn = 0;
+		S glb;
+		S expl;
+		S yi;
+		S densa;
+		S gamma, gamm;
+		S xs[5], ys[5], y2out[5];
 
 		/* joining altitudes of Bates and spline */
 		za = zn1[0];
-		z = (alt > za) ? alt : za;
+		z = (alt >= za) ? alt : za;
 
 		/* geo-potential altitude difference from ZLB */
-		zg2 = zeta(z, zlb);
+		zg2 = zeta(z, zlb, ws);
 
 		/* Bates temperature */
-		tt = tinf - (tinf - tlb) * std::exp(-s2 * zg2);
+		tt = tinf - (tinf - tlb) * lane::exp(-s2 * zg2);
 		ta = tt;
 		tz = tt;
 		densu_temp = tz;
 
 		if (alt < za) {
 			/* calculate temperature below ZA temperature gradient at ZA from Bates profile */
-			dta = (tinf - ta) * s2 * std::pow(((re + zlb) / (re + za)), 2.0);
+			dta = (tinf - ta) * s2 * lane::ipow<2>((ws.re + zlb) / (ws.re + za));
 			tgn1[0] = dta;
 			tn1[0] = ta;
-			z = (alt > zn1[mn1 - 1]) ? alt : zn1[mn1 - 1];
+			z = (alt >= zn1[mn1 - 1]) ? alt : zn1[mn1 - 1];
 			mn = mn1;
 			z1 = zn1[0];
 			z2 = zn1[mn - 1];
@@ -419,23 +1077,23 @@ namespace internal {
 			t2 = tn1[mn - 1];
 
 			/* geo-potential difference from z1 */
-			zg = zeta(z, z1);
-			zgdif = zeta(z2, z1);
+			zg = zeta(z, z1, ws);
+			zgdif = zeta(z2, z1, ws);
 
 			/* set up spline nodes */
 			for (int k = 0; k < mn; k++) {
-				xs[k] = zeta(zn1[k], z1) / zgdif;
+				xs[k] = zeta(zn1[k], z1, ws) / zgdif;
 				ys[k] = 1.0 / tn1[k];
 			}
 
 			/* end node derivatives */
 			yd1 = -tgn1[0] / (t1 * t1) * zgdif;
-			yd2 = -tgn1[1] / (t2 * t2) * zgdif * std::pow(((re + z2) / (re + z1)), 2.0);
+			yd2 = -tgn1[1] / (t2 * t2) * zgdif * lane::ipow<2>((ws.re + z2) / (ws.re + z1));
 
 			/* calculate spline coefficients */
 			spline(xs, ys, mn, yd1, yd2, y2out);
 			x = zg / zgdif;
-			splint(xs, ys, y2out, mn, x, y);
+			splint(xs, ys, y2out, mn, x, y, ws);
 			/* temperature at altitude */
 			tz = 1.0 / y;
 			densu_temp = tz;
@@ -444,19 +1102,19 @@ namespace internal {
 		if (xm == 0) return densu_temp;
 
 		/* calculate density above za */
-		glb = gsurf / std::pow((1.0 + zlb / re), 2.0);
+		glb = ws.gsurf / lane::ipow<2>(1.0 + zlb / ws.re);
 		gamma = xm * glb / (s2 * rgas * tinf);
-		expl = std::exp(-s2 * gamma * zg2);
+		expl = lane::exp(-s2 * gamma * zg2);
 		if (expl > 50.0) expl = 50.0;
 		if (tt <= 0) expl = 50.0;
 
 		/* density at altitude */
-		densa = dlb * std::pow((tlb / tt), ((1.0 + alpha + gamma))) * expl;
+		densa = dlb * lane::pow(tlb / tt, 1.0 + alpha + gamma) * expl;
 		densu_temp = densa;
 		if (alt >= za) return densu_temp;
 
 		/* calculate density below za */
-		glb = gsurf / std::pow((1.0 + z1 / re), 2.0);
+		glb = ws.gsurf / lane::ipow<2>(1.0 + z1 / ws.re);
 		gamm = xm * glb * zgdif / rgas;
 
 		/* integrate spline temperatures */
@@ -466,29 +1124,69 @@ namespace internal {
 		if (tz <= 0) expl = 50.0;
 
 		/* density at altitude */
-		densu_temp = densu_temp * std::pow((t1 / tz), (1.0 + alpha)) * std::exp(-expl);
+		densu_temp = densu_temp * lane::pow(t1 / tz, 1.0 + alpha) * lane::exp(-expl);
 		return densu_temp;
 	}
 
-	double Nrlmsise::globe7(double *p, NrlmsiseInput &input, NrlmsiseConfig &flags) {
-		double t[15];
-		double apd;
-		double tloc;
-		double c, s, c2, c4, s2;
-		double cd32, cd18, cd14, cd39;
-		double df;
-		double f1, f2;
-		double tinf;
+	inline NrlmsiseRowPhases Nrlmsise::rowPhases(const double *p, int n) {
+		constexpr double days_per_year = constant::days_per_nonleap_year;
+		constexpr double seconds_per_day = constant::seconds_per_day;
+		auto phase = [](double angle) { return NrlmsisePhase{std::cos(angle), std::sin(angle)}; };
+		auto doy = [&](double k, double shift) { return phase(constant::pi2 * (k * shift) / days_per_year); };
+		NrlmsiseRowPhases ph{};
+
+		ph.doy13 = doy(1.0, p[13]);
+		ph.doy17 = doy(2.0, p[17]);
+		ph.doy31 = doy(1.0, p[31]);
+		ph.doy38 = doy(2.0, p[38]);
+		ph.doy81 = doy(1.0, p[81]);
+		ph.doy84 = doy(1.0, p[84]);
+		ph.doy86 = doy(2.0, p[86]);
+		ph.doy88 = doy(2.0, p[88]);
+		ph.deg63 = phase(p[63] * constant::pi / 180.0);
+		ph.deg97 = phase(p[97] * constant::pi / 180.0);
+		ph.ut58 = phase(constant::pi2 * (p[58] / seconds_per_day));
+		ph.ut71 = phase(constant::pi2 * (p[71] / seconds_per_day));
+		ph.ut75 = phase(constant::pi2 * (p[75] / seconds_per_day));
+		ph.ut79 = phase(constant::pi2 * (p[79] / seconds_per_day));
+
+		/* glob7s rows have no coefficients beyond 99 */
+		if (n > 100) {
+			ph.hour124 = phase(p[124] * constant::pi / 12.0);
+			ph.hour131 = phase(p[131] * constant::pi / 12.0);
+			ph.deg118 = phase(p[118] * constant::pi / 180.0);
+			ph.deg136 = phase(p[136] * constant::pi / 180.0);
+		}
+		return ph;
+	}
 
-		tloc = input.lst;
-		std::fill_n(t, 14, 0);
+	inline const NrlmsisePhaseTable &Nrlmsise::phaseTable() {
+		static const NrlmsisePhaseTable table = [] {
+			NrlmsisePhaseTable t;
+			t.pt = rowPhases(pt, 150);
+			t.ps = rowPhases(ps, 150);
+			for (int i = 0; i < 9; i++) t.pd[i] = rowPhases(pd[i], 150);
+			for (int i = 0; i < 4; i++) t.ptl[i] = rowPhases(ptl[i], 100);
+			for (int i = 0; i < 10; i++) t.pma[i] = rowPhases(pma[i], 100);
+			return t;
+		}();
+		return table;
+	}
+
+	template <class T, class Input, class Flags>
+	void Nrlmsise::globeBasis(const Input &input, const Flags &flags, NrlmsiseBasis<T> &b) const {
+		constexpr double days_per_year = constant::days_per_nonleap_year;
+		constexpr double seconds_per_day = constant::seconds_per_day;
+		using C = NrlmsiseConstant<T>;
+		auto &plg = b.plg;
 
 		/* calculate legendre polynomials */
-		c = Degree(input.g_lat).sin();
-		s = Degree(input.g_lat).cos();
-		c2 = c * c;
-		c4 = c2 * c2;
-		s2 = s * s;
+		const T lat = input.g_lat * constant::pi / 180.0;
+		const T c = lane::sin(lat);
+		const T s = lane::cos(lat);
+		const T c2 = c * c;
+		const T c4 = c2 * c2;
+		const T s2 = s * s;
 
 		plg[0][1] = c;
 		plg[0][2] = 0.5 * (3.0 * c2 - 1.0);
@@ -516,26 +1214,70 @@ namespace internal {
 		plg[3][5] = (9.0 * c * plg[3][4] - 7. * plg[3][3]) / 2.0;
 		plg[3][6] = (11.0 * c * plg[3][5] - 8. * plg[3][4]) / 3.0;
 
+		/* local time harmonics */
 		if (!(((flags.sw[7] == 0) && (flags.sw[8] == 0)) && (flags.sw[14] == 0))) {
-			stloc = HourAngle(tloc).sin();
-			ctloc = HourAngle(tloc).cos();
-			s2tloc = HourAngle(2.0 * tloc).sin();
-			c2tloc = HourAngle(2.0 * tloc).cos();
-			s3tloc = HourAngle(3.0 * tloc).sin();
-			c3tloc = HourAngle(3.0 * tloc).cos();
+			const T tloc = input.lst * constant::pi / 12.0;
+			b.stloc = lane::sin(tloc);
+			b.ctloc = lane::cos(tloc);
+			b.s2tloc = lane::sin(2.0 * tloc);
+			b.c2tloc = lane::cos(2.0 * tloc);
+			b.s3tloc = lane::sin(3.0 * tloc);
+			b.c3tloc = lane::cos(3.0 * tloc);
+		} else {
+			b.stloc = b.ctloc = b.s2tloc = b.c2tloc = b.s3tloc = b.c3tloc = lane::constant<T>(0.0);
 		}
 
-		cd32 = DoyAngle(input.doy - p[31]).cos();
-		cd18 = DoyAngle(2.0 * (input.doy - p[17])).cos();
-		cd14 = DoyAngle(input.doy - p[13]).cos();
-		cd39 = DoyAngle(2.0 * (input.doy - p[38])).cos();
+		/* day of year harmonics */
+		const C doy = constant::pi2 * input.doy / days_per_year;
+		b.cdoy = lane::cos(doy);
+		b.sdoy = lane::sin(doy);
+		b.c2doy = lane::cos(2.0 * doy);
+		b.s2doy = lane::sin(2.0 * doy);
+
+		/* longitude and universal time harmonics */
+		const T lon = input.g_long * constant::pi / 180.0;
+		const C ut = constant::pi2 * (input.sec / seconds_per_day);
+		b.clong = lane::cos(lon);
+		b.slong = lane::sin(lon);
+		b.cut = lane::cos(ut);
+		b.sut = lane::sin(ut);
+		b.cut2long = lane::cos(ut + 2.0 * lon);
+		b.sut2long = lane::sin(ut + 2.0 * lon);
+		b.has_long = lane::mask<C>(input.g_long > -1000.0);
+		b.abs_lat = lane::sqrt(input.g_lat * input.g_lat);
 
 		/* F10.7 EFFECT */
-		df = input.f107 - input.f107A;
-		dfa = input.f107A - 150.0;
-		t[0] = p[19] * df * (1.0 + p[59] * dfa) + p[20] * df * df + p[21] * dfa + p[29] * std::pow(dfa, 2.0);
-		f1 = 1.0 + (p[47] * dfa + p[19] * df + p[20] * df * df) * flags.swc[1];
-		f2 = 1.0 + (p[49] * dfa + p[19] * df + p[20] * df * df) * flags.swc[1];
+		b.df = input.f107 - input.f107A;
+		b.dfa = input.f107A - 150.0;
+
+		/* magnetic activity */
+		b.apd = input.ap - 4.0;
+		for (int i = 0; i < 7; i++) b.ap[i] = input.ap_a.a[i];
+	}
+
+	template <class T, class Flags>
+	T Nrlmsise::globe7(const double *p, const NrlmsiseRowPhases &ph, const NrlmsiseBasis<T> &b, const Flags &flags,
+					   NrlmsiseApContext<T> &ctx) const {
+		using C = NrlmsiseConstant<T>;
+		const auto &plg = b.plg;
+		const C &df = b.df, &dfa = b.dfa;
+		const T &ctloc = b.ctloc, &stloc = b.stloc, &c2tloc = b.c2tloc, &s2tloc = b.s2tloc;
+		const T &c3tloc = b.c3tloc, &s3tloc = b.s3tloc;
+		C &apdf = ctx.apdf;
+		T &apt = ctx.apt;
+		T t[14];
+		for (auto &ti : t) ti = lane::constant<T>(0.0);
+
+		/* cos(x - shift) = cos(x) cos(shift) + sin(x) sin(shift) */
+		const C cd32 = shifted(b.cdoy, b.sdoy, ph.doy31);
+		const C cd18 = shifted(b.c2doy, b.s2doy, ph.doy17);
+		const C cd14 = shifted(b.cdoy, b.sdoy, ph.doy13);
+		const C cd39 = shifted(b.c2doy, b.s2doy, ph.doy38);
+
+		/* F10.7 EFFECT */
+		t[0] = p[19] * df * (1.0 + p[59] * dfa) + p[20] * df * df + p[21] * dfa + p[29] * dfa * dfa;
+		const C f1 = 1.0 + (p[47] * dfa + p[19] * df + p[20] * df * df) * flags.swc[1];
+		const C f2 = 1.0 + (p[49] * dfa + p[19] * df + p[20] * df * df) * flags.swc[1];
 
 		/*  TIME INDEPENDENT */
 		t[1] = (p[1] * plg[0][2] + p[2] * plg[0][4] + p[22] * plg[0][6]) + (p[14] * plg[0][2]) * dfa * flags.swc[1] + p[26] * plg[0][1];
@@ -554,18 +1296,16 @@ namespace internal {
 
 		/* DIURNAL */
 		if (flags.sw[7]) {
-			double t71, t72;
-			t71 = (p[11] * plg[1][2]) * cd14 * flags.swc[5];
-			t72 = (p[12] * plg[1][2]) * cd14 * flags.swc[5];
+			const T t71 = (p[11] * plg[1][2]) * cd14 * flags.swc[5];
+			const T t72 = (p[12] * plg[1][2]) * cd14 * flags.swc[5];
 			t[6] = f2 * ((p[3] * plg[1][1] + p[4] * plg[1][3] + p[27] * plg[1][5] + t71) * ctloc +
 						 (p[6] * plg[1][1] + p[7] * plg[1][3] + p[28] * plg[1][5] + t72) * stloc);
 		}
 
 		/* SEMIDIURNAL */
 		if (flags.sw[8]) {
-			double t81, t82;
-			t81 = (p[23] * plg[2][3] + p[35] * plg[2][5]) * cd14 * flags.swc[5];
-			t82 = (p[33] * plg[2][3] + p[36] * plg[2][5]) * cd14 * flags.swc[5];
+			const T t81 = (p[23] * plg[2][3] + p[35] * plg[2][5]) * cd14 * flags.swc[5];
+			const T t82 = (p[33] * plg[2][3] + p[36] * plg[2][5]) * cd14 * flags.swc[5];
 			t[7] = f2 * ((p[5] * plg[2][2] + p[41] * plg[2][4] + t81) * c2tloc + (p[8] * plg[2][2] + p[42] * plg[2][4] + t82) * s2tloc);
 		}
 
@@ -577,113 +1317,116 @@ namespace internal {
 
 		/* magnetic activity based on daily ap */
 		if (flags.sw[9] == -1) {
-			ApArray &ap = input.ap_a;
 			if (p[51] != 0) {
-				double exp1;
-				exp1 = std::exp(-10800.0 * std::sqrt(p[51] * p[51]) / (1.0 + p[138] * (45.0 - std::sqrt(input.g_lat * input.g_lat))));
-				if (exp1 > 0.99999) exp1 = 0.99999;
-				if (p[24] < 1.0E-4) p[24] = 1.0E-4;
-				apt[0] = sg0(exp1, p, ap.a);
+				const T exp1 =
+				  lane::min(lane::exp(-10800.0 * std::fabs(p[51]) / (1.0 + p[138] * (45.0 - b.abs_lat))), 0.99999);
+				const double p24 = (p[24] < 1.0E-4) ? 1.0E-4 : p[24];
+				apt = sg0(exp1, p, p24, b.ap);
 				/* apt[1]=sg2(exp1,p,ap.a);
 				   apt[2]=sg0(exp2,p,ap.a);
 				   apt[3]=sg2(exp2,p,ap.a);
 				*/
 				if (flags.sw[9]) {
-					t[8] = apt[0] *
-						   (p[50] + p[96] * plg[0][2] + p[54] * plg[0][4] +
-							(p[125] * plg[0][1] + p[126] * plg[0][3] + p[127] * plg[0][5]) * cd14 * flags.swc[5] +
-							(p[128] * plg[1][1] + p[129] * plg[1][3] + p[130] * plg[1][5]) * flags.swc[7] * HourAngle(tloc - p[131]).cos());
+					t[8] = apt * (p[50] + p[96] * plg[0][2] + p[54] * plg[0][4] +
+								  (p[125] * plg[0][1] + p[126] * plg[0][3] + p[127] * plg[0][5]) * cd14 * flags.swc[5] +
+								  (p[128] * plg[1][1] + p[129] * plg[1][3] + p[130] * plg[1][5]) * flags.swc[7] *
+									shifted(ctloc, stloc, ph.hour131));
 				}
 			}
 		} else {
-			double p44, p45;
-			apd = input.ap - 4.0;
-			p44 = p[43];
-			p45 = p[44];
+			const C &apd = b.apd;
+			double p44 = p[43];
+			double p45 = p[44];
 			if (p44 < 0) p44 = 1.0E-5;
-			apdf = apd + (p45 - 1.0) * (apd + (std::exp(-p44 * apd) - 1.0) / p44);
+			apdf = apd + (p45 - 1.0) * (apd + (lane::exp(-p44 * apd) - 1.0) / p44);
 			if (flags.sw[9]) {
-				t[8] =
-				  apdf * (p[32] + p[45] * plg[0][2] + p[34] * plg[0][4] +
-						  (p[100] * plg[0][1] + p[101] * plg[0][3] + p[102] * plg[0][5]) * cd14 * flags.swc[5] +
-						  (p[121] * plg[1][1] + p[122] * plg[1][3] + p[123] * plg[1][5]) * flags.swc[7] * HourAngle(tloc - p[124]).cos());
+				t[8] = apdf * (p[32] + p[45] * plg[0][2] + p[34] * plg[0][4] +
+							   (p[100] * plg[0][1] + p[101] * plg[0][3] + p[102] * plg[0][5]) * cd14 * flags.swc[5] +
+							   (p[121] * plg[1][1] + p[122] * plg[1][3] + p[123] * plg[1][5]) * flags.swc[7] *
+								 shifted(ctloc, stloc, ph.hour124));
 			}
 		}
 
-		if ((flags.sw[10]) && (input.g_long > -1000.0)) {
+		if (flags.sw[10]) {
+			const T &clong = b.clong, &slong = b.slong;
 
 			/* longitudinal */
 			if (flags.sw[11]) {
 				t[10] = (1.0 + p[80] * dfa * flags.swc[1]) *
 						((p[64] * plg[1][2] + p[65] * plg[1][4] + p[66] * plg[1][6] + p[103] * plg[1][1] + p[104] * plg[1][3] +
 						  p[105] * plg[1][5] + flags.swc[5] * (p[109] * plg[1][1] + p[110] * plg[1][3] + p[111] * plg[1][5]) * cd14) *
-						   Degree(input.g_long).cos() +
+						   clong +
 						 (p[90] * plg[1][2] + p[91] * plg[1][4] + p[92] * plg[1][6] + p[106] * plg[1][1] + p[107] * plg[1][3] +
 						  p[108] * plg[1][5] + flags.swc[5] * (p[112] * plg[1][1] + p[113] * plg[1][3] + p[114] * plg[1][5]) * cd14) *
-						   Degree(input.g_long).sin());
+						   slong);
 			}
 
 			/* ut and mixed ut, longitude */
 			if (flags.sw[12]) {
 				t[11] = (1.0 + p[95] * plg[0][1]) * (1.0 + p[81] * dfa * flags.swc[1]) * (1.0 + p[119] * plg[0][1] * flags.swc[5] * cd14) *
-						((p[68] * plg[0][1] + p[69] * plg[0][3] + p[70] * plg[0][5]) *
-						 NormalizedAngle((input.sec - p[71]) / constant::seconds_per_day).cos());
+						((p[68] * plg[0][1] + p[69] * plg[0][3] + p[70] * plg[0][5]) * shifted(b.cut, b.sut, ph.ut71));
 				t[11] += flags.swc[11] * (p[76] * plg[2][3] + p[77] * plg[2][5] + p[78] * plg[2][7]) *
-						 (NormalizedAngle((input.sec - p[79]) / constant::seconds_per_day) + 2.0 * Degree(input.g_long)).cos() *
-						 (1.0 + p[137] * dfa * flags.swc[1]);
+						 shifted(b.cut2long, b.sut2long, ph.ut79) * (1.0 + p[137] * dfa * flags.swc[1]);
 			}
 
 			/* ut, longitude magnetic activity */
 			if (flags.sw[13]) {
 				if (flags.sw[9] == -1) {
 					if (p[51]) {
-						t[12] = apt[0] * flags.swc[11] * (1. + p[132] * plg[0][1]) *
-								  ((p[52] * plg[1][2] + p[98] * plg[1][4] + p[67] * plg[1][6]) * Degree(input.g_long - p[97]).cos()) +
-								apt[0] * flags.swc[11] * flags.swc[5] * (p[133] * plg[1][1] + p[134] * plg[1][3] + p[135] * plg[1][5]) *
-								  cd14 * Degree(input.g_long - p[136]).cos() +
-								apt[0] * flags.swc[12] * (p[55] * plg[0][1] + p[56] * plg[0][3] + p[57] * plg[0][5]) *
-								  NormalizedAngle((input.sec - p[58]) / constant::seconds_per_day).cos();
+						t[12] = apt * flags.swc[11] * (1. + p[132] * plg[0][1]) *
+								  ((p[52] * plg[1][2] + p[98] * plg[1][4] + p[67] * plg[1][6]) * shifted(clong, slong, ph.deg97)) +
+								apt * flags.swc[11] * flags.swc[5] * (p[133] * plg[1][1] + p[134] * plg[1][3] + p[135] * plg[1][5]) * cd14 *
+								  shifted(clong, slong, ph.deg136) +
+								apt * flags.swc[12] * (p[55] * plg[0][1] + p[56] * plg[0][3] + p[57] * plg[0][5]) *
+								  shifted(b.cut, b.sut, ph.ut58);
 					}
 				} else {
 					t[12] = apdf * flags.swc[11] * (1.0 + p[120] * plg[0][1]) *
-							  ((p[60] * plg[1][2] + p[61] * plg[1][4] + p[62] * plg[1][6]) * Degree(input.g_long - p[63]).cos()) +
+							  ((p[60] * plg[1][2] + p[61] * plg[1][4] + p[62] * plg[1][6]) * shifted(clong, slong, ph.deg63)) +
 							apdf * flags.swc[11] * flags.swc[5] * (p[115] * plg[1][1] + p[116] * plg[1][3] + p[117] * plg[1][5]) * cd14 *
-							  Degree(input.g_long - p[118]).cos() +
+							  shifted(clong, slong, ph.deg118) +
 							apdf * flags.swc[12] * (p[83] * plg[0][1] + p[84] * plg[0][3] + p[85] * plg[0][5]) *
-							  NormalizedAngle((input.sec - p[75]) / constant::seconds_per_day).cos();
+							  shifted(b.cut, b.sut, ph.ut75);
 				}
 			}
+
+			/* no longitude dependence for g_long <= -1000 */
+			for (int i = 10; i < 13; i++) t[i] = t[i] * b.has_long;
 		}
 
 		/* parms not used: 82, 89, 99, 139-149 */
-		tinf = p[30];
+		T tinf = lane::constant<T>(p[30]);
 		for (int i = 0; i < 14; i++) tinf = tinf + std::fabs(flags.sw[i + 1]) * t[i];
 		return tinf;
 	}
 
-	double Nrlmsise::glob7s(double *p, NrlmsiseInput &input, NrlmsiseConfig &flags) {
+	template <class T, class Flags>
+	T Nrlmsise::glob7s(const double *p, const NrlmsiseRowPhases &ph, const NrlmsiseBasis<T> &b, const Flags &flags,
+					   const NrlmsiseApContext<T> &ctx) const {
+		using C = NrlmsiseConstant<T>;
+		const auto &plg = b.plg;
+		const T &ctloc = b.ctloc, &stloc = b.stloc, &c2tloc = b.c2tloc, &s2tloc = b.s2tloc;
+		const T &c3tloc = b.c3tloc, &s3tloc = b.s3tloc;
+		const C &apdf = ctx.apdf;
+		const T &apt = ctx.apt;
 		/*    VERSION OF GLOBE FOR LOWER ATMOSPHERE 10/26/99  */
 		constexpr double pset = 2.0;
-		double t[14];
-		double tt;
-		double cd32, cd18, cd14, cd39;
+		T t[14];
 
 		/* confirm parameter set */
-		if (p[99] == 0) p[99] = pset;
-		if (p[99] != pset) {
+		if ((p[99] != 0) && (p[99] != pset)) {
 			throw AtmosModelException("Incorrect Low Atmosphere Globe model settings.", AtmosModelException::InvalidValue);
-			return -1;
 		}
 
-		std::fill_n(t, 14, 0.0);
+		for (auto &ti : t) ti = lane::constant<T>(0.0);
 
-		cd32 = DoyAngle(input.doy - p[31]).cos();
-		cd18 = DoyAngle(2.0 * (input.doy - p[17])).cos();
-		cd14 = DoyAngle(input.doy - p[13]).cos();
-		cd39 = DoyAngle(2.0 * (input.doy - p[38])).cos();
+		const C cd32 = shifted(b.cdoy, b.sdoy, ph.doy31);
+		const C cd18 = shifted(b.c2doy, b.s2doy, ph.doy17);
+		const C cd14 = shifted(b.cdoy, b.sdoy, ph.doy13);
+		const C cd39 = shifted(b.c2doy, b.s2doy, ph.doy38);
 
 		/* F10.7 */
-		t[0] = p[21] * dfa;
+		t[0] = p[21] * b.dfa;
 
 		/* Time independent */
 		t[1] = p[1] * plg[0][2] + p[2] * plg[0][4] + p[22] * plg[0][6] + p[26] * plg[0][1] + p[14] * plg[0][3] + p[59] * plg[0][5];
@@ -702,17 +1445,15 @@ namespace internal {
 
 		/* Diurnal */
 		if (flags.sw[7]) {
-			double t71, t72;
-			t71 = p[11] * plg[1][2] * cd14 * flags.swc[5];
-			t72 = p[12] * plg[1][2] * cd14 * flags.swc[5];
+			const T t71 = p[11] * plg[1][2] * cd14 * flags.swc[5];
+			const T t72 = p[12] * plg[1][2] * cd14 * flags.swc[5];
 			t[6] = ((p[3] * plg[1][1] + p[4] * plg[1][3] + t71) * ctloc + (p[6] * plg[1][1] + p[7] * plg[1][3] + t72) * stloc);
 		}
 
 		/* Semidiurnal */
 		if (flags.sw[8]) {
-			double t81, t82;
-			t81 = (p[23] * plg[2][3] + p[35] * plg[2][5]) * cd14 * flags.swc[5];
-			t82 = (p[33] * plg[2][3] + p[36] * plg[2][5]) * cd14 * flags.swc[5];
+			const T t81 = (p[23] * plg[2][3] + p[35] * plg[2][5]) * cd14 * flags.swc[5];
+			const T t82 = (p[33] * plg[2][3] + p[36] * plg[2][5]) * cd14 * flags.swc[5];
 			t[7] = ((p[5] * plg[2][2] + p[41] * plg[2][4] + t81) * c2tloc + (p[8] * plg[2][2] + p[42] * plg[2][4] + t82) * s2tloc);
 		}
 
@@ -724,54 +1465,145 @@ namespace internal {
 		/* Magnetic activity */
 		if (flags.sw[9]) {
 			if (flags.sw[9] == 1) t[8] = apdf * (p[32] + p[45] * plg[0][2] * flags.swc[2]);
-			if (flags.sw[9] == -1) t[8] = (p[50] * apt[0] + p[96] * plg[0][2] * apt[0] * flags.swc[2]);
+			if (flags.sw[9] == -1) t[8] = (p[50] * apt + p[96] * plg[0][2] * apt * flags.swc[2]);
 		}
 
 		/* longitudinal */
-		if (!((flags.sw[10] == 0) || (flags.sw[11] == 0) || (input.g_long <= -1000.0))) {
-			t[10] =
-			  (1.0 +
-			   plg[0][1] * (p[80] * flags.swc[5] * DoyAngle(input.doy - p[81]).cos() +
-							p[85] * flags.swc[6] * DoyAngle(2.0 * (input.doy - p[86])).cos()) +
-			   p[83] * flags.swc[3] * DoyAngle(input.doy - p[84]).cos() +
-			   p[87] * flags.swc[4] * DoyAngle(2.0 * (input.doy - p[88])).cos()) *
-			  ((p[64] * plg[1][2] + p[65] * plg[1][4] + p[66] * plg[1][6] + p[74] * plg[1][1] + p[75] * plg[1][3] + p[76] * plg[1][5]) *
-				 Degree(input.g_long).cos() +
-			   (p[90] * plg[1][2] + p[91] * plg[1][4] + p[92] * plg[1][6] + p[77] * plg[1][1] + p[78] * plg[1][3] + p[79] * plg[1][5]) *
-				 Degree(input.g_long).sin());
-		}
-		tt = 0;
+		if (!((flags.sw[10] == 0) || (flags.sw[11] == 0))) {
+			const T lon_c =
+			  p[64] * plg[1][2] + p[65] * plg[1][4] + p[66] * plg[1][6] + p[74] * plg[1][1] + p[75] * plg[1][3] + p[76] * plg[1][5];
+			const T lon_s =
+			  p[90] * plg[1][2] + p[91] * plg[1][4] + p[92] * plg[1][6] + p[77] * plg[1][1] + p[78] * plg[1][3] + p[79] * plg[1][5];
+			t[10] = (1.0 +
+					 plg[0][1] * (p[80] * flags.swc[5] * shifted(b.cdoy, b.sdoy, ph.doy81) +
+								  p[85] * flags.swc[6] * shifted(b.c2doy, b.s2doy, ph.doy86)) +
+					 p[83] * flags.swc[3] * shifted(b.cdoy, b.sdoy, ph.doy84) +
+					 p[87] * flags.swc[4] * shifted(b.c2doy, b.s2doy, ph.doy88)) *
+					(lon_c * b.clong + lon_s * b.slong) * b.has_long;
+		}
+
+		T tt = lane::constant<T>(0.0);
 		for (int i = 0; i < 14; i++) tt += std::fabs(flags.sw[i + 1]) * t[i];
 		return tt;
 	}
 
-	void Nrlmsise::gtd7d(NrlmsiseInput &input, NrlmsiseConfig &flags, NrlmsiseOutput &output) {
-		gtd7(input, flags, output);
+	template <class T, class Flags>
+	void Nrlmsise::globeRows(const NrlmsiseBasis<T> &b, const Flags &flags, NrlmsiseGlobeTermsT<T> &terms) const {
+		const NrlmsisePhaseTable &ph = phaseTable();
+		NrlmsiseApContext<T> ctx{lane::constant<NrlmsiseConstant<T>>(0.0), lane::constant<T>(0.0)};
+
+		/* glob7s uses apt / apdf left by the preceding globe7, so rows are evaluated in the order gts7 / gtd7 refer to them */
+		terms.pt = globe7(pt, ph.pt, b, flags, ctx);
+		terms.ps = globe7(ps, ph.ps, b, flags, ctx);
+		terms.pd[3] = globe7(pd[3], ph.pd[3], b, flags, ctx);
+
+		if (terms.has_ptl) {
+			for (int i = 0; i < 4; i++) terms.ptl[i] = glob7s(ptl[i], ph.ptl[i], b, flags, ctx);
+			terms.pma[8] = glob7s(pma[8], ph.pma[8], b, flags, ctx);
+		}
+
+		for (int i : {2, 0, 1, 4, 5, 6, 7, 8}) terms.pd[i] = globe7(pd[i], ph.pd[i], b, flags, ctx);
+
+		if (terms.has_pma) {
+			for (int i : {0, 1, 2, 9, 3, 4, 5, 6, 7}) terms.pma[i] = glob7s(pma[i], ph.pma[i], b, flags, ctx);
+		}
+	}
+
+	template <class S, class Flags>
+	void Nrlmsise::globeTerms(const NrlmsiseInputT<S> &input, const Flags &flags, NrlmsiseGlobeTermsT<S> &terms) const {
+		NrlmsiseBasis<S> basis;
+		globeBasis(input, flags, basis);
+
+		terms.has_ptl = input.alt < ptl_altitude_limit;
+		terms.has_pma = input.alt < pma_altitude_limit;
+		globeRows(basis, flags, terms);
+	}
+
+	template <int W, class S, class Flags>
+	void Nrlmsise::globeTermsLanes(const NrlmsiseInputLanes<W, S> &input, const Flags &flags, NrlmsiseGlobeTerms *terms) const {
+		NrlmsiseBasis<NrlmsiseLanes<W, S>> basis;
+		NrlmsiseGlobeTermsT<NrlmsiseLanes<W, S>> v;
+		globeBasis(input, flags, basis);
+
+		v.has_ptl = (input.alt < ptl_altitude_limit).any();
+		v.has_pma = (input.alt < pma_altitude_limit).any();
+		globeRows(basis, flags, v);
+
+		for (int l = 0; l < W; l++) {
+			NrlmsiseGlobeTerms &tl = terms[l];
+			tl.pt = v.pt[l];
+			tl.ps = v.ps[l];
+			for (int i = 0; i < 9; i++) tl.pd[i] = v.pd[i][l];
+			tl.has_ptl = v.has_ptl;
+			if (v.has_ptl) {
+				for (int i = 0; i < 4; i++) tl.ptl[i] = v.ptl[i][l];
+				tl.pma[8] = v.pma[8][l];
+			}
+			tl.has_pma = v.has_pma;
+			if (v.has_pma) {
+				for (int i : {0, 1, 2, 3, 4, 5, 6, 7, 9}) tl.pma[i] = v.pma[i][l];
+			}
+		}
+	}
+
+	template <class Flags>
+	void Nrlmsise::gtd7d(const NrlmsiseInput &input, const Flags &flags, NrlmsiseOutput &output, NrlmsiseWorkspace &ws) const {
+		gtd7(input, flags, output, ws);
 
 		output.d[5] = 1.66E-24 * (4.0 * output.d[0] + 16.0 * output.d[1] + 28.0 * output.d[2] + 32.0 * output.d[3] + 40.0 * output.d[4] +
 								  output.d[6] + 14.0 * output.d[7] + 16.0 * output.d[8]);
 		if (flags.sw[0]) output.d[5] /= 1000;
 	}
 
-	void Nrlmsise::gtd7(NrlmsiseInput &input, NrlmsiseConfig &flags, NrlmsiseOutput &output) {
+	template <class S, class Flags>
+	void Nrlmsise::gtd7(const NrlmsiseInputT<S> &input, const Flags &flags, NrlmsiseOutputT<S> &output, NrlmsiseWorkspaceT<S> &ws,
+						const NrlmsiseArg<NrlmsiseGlobeTermsT<S>> *terms, NrlmsiseArg<NrlmsiseColumnCacheT<S>> *cache) const {
+		S *meso_tn1 = ws.meso_tn1, *meso_tn2 = ws.meso_tn2, *meso_tn3 = ws.meso_tn3;
+		S *meso_tgn1 = ws.meso_tgn1, *meso_tgn2 = ws.meso_tgn2, *meso_tgn3 = ws.meso_tgn3;
 		constexpr double zmix = 62.5;
 		double zn2[4] = {72.5, 55.0, 45.0, 32.5};
 		double zn3[5] = {32.5, 20.0, 15.0, 10.0, 0.0};
 
-		NrlmsiseOutput soutput;
+		NrlmsiseOutputT<S> soutput;
 
-		/* Configure flags */
-		tselec(flags);
+		/* flags must be configured by tselec() before calling (or be a StaticConfig) */
+
+		/* Spherical harmonics expansions (evaluated here unless supplied by the caller) */
+		NrlmsiseGlobeTermsT<S> local_terms;
+		if (!terms) {
+			globeTerms(input, flags, local_terms);
+			terms = &local_terms;
+		} else if ((input.alt < ptl_altitude_limit && !terms->has_ptl) || (input.alt < pma_altitude_limit && !terms->has_pma)) {
+			if (!ws.nothrow) {
+				throw AtmosModelException("Spherical harmonics terms do not cover the input altitude.", AtmosModelException::InvalidValue);
+			}
+			/* recompute the expansions that the supplied terms lack */
+			globeTerms(input, flags, local_terms);
+			terms = &local_terms;
+		}
 
 		/* Latitude variation of gravity (none for sw[2]=0) */
-		double xlat = (flags.sw[2] == 0) ? 45.0 : input.g_lat;
-		glatf(xlat, gsurf, re);
+		const S xlat = (flags.sw[2] == 0) ? 45.0 : input.g_lat;
+		glatf(xlat, ws.gsurf, ws.re);
 
 		/* Thermosphere / mesosphere (above zn2[0]) */
-		double altt = (input.alt > zn2[0]) ? input.alt : zn2[0];
-		std::swap(input.alt, altt);
-		gts7(input, flags, soutput);
-		std::swap(input.alt, altt);
+		NrlmsiseInputT<S> tinput = input;
+		tinput.alt = (input.alt >= zn2[0]) ? input.alt : zn2[0];
+		if (input.alt < zn2[0] && cache && cache->has_mesopause) {
+			/* every level below zn2[0] evaluates gts7 at zn2[0] */
+			const NrlmsiseColumnT<S> &column = cache->columns[columnRegime(zn2[0])];
+			std::copy(std::begin(column.meso_tn1), std::end(column.meso_tn1), meso_tn1);
+			std::copy(std::begin(column.meso_tgn1), std::end(column.meso_tgn1), meso_tgn1);
+			soutput = cache->mesopause;
+			ws.dm28 = cache->mesopause_dm28;
+		} else {
+			gts7(tinput, flags, *terms, soutput, ws, cache);
+			if (input.alt < zn2[0] && cache) {
+				cache->mesopause = soutput;
+				cache->mesopause_dm28 = ws.dm28;
+				cache->has_mesopause = true;
+			}
+		}
 
 		output.t[0] = soutput.t[0];
 		output.t[1] = soutput.t[1];
@@ -788,11 +1620,11 @@ namespace internal {
 		 **/
 		meso_tgn2[0] = meso_tgn1[1];
 		meso_tn2[0] = meso_tn1[4];
-		meso_tn2[1] = pma[0][0] * pavgm[0] / (1.0 - flags.sw[20] * glob7s(pma[0], input, flags));
-		meso_tn2[2] = pma[1][0] * pavgm[1] / (1.0 - flags.sw[20] * glob7s(pma[1], input, flags));
-		meso_tn2[3] = pma[2][0] * pavgm[2] / (1.0 - flags.sw[20] * flags.sw[22] * glob7s(pma[2], input, flags));
-		meso_tgn2[1] = pavgm[8] * pma[9][0] * (1.0 + flags.sw[20] * flags.sw[22] * glob7s(pma[9], input, flags)) * meso_tn2[3] *
-					   meso_tn2[3] / (std::pow((pma[2][0] * pavgm[2]), 2.0));
+		meso_tn2[1] = pma[0][0] * pavgm[0] / (1.0 - flags.sw[20] * terms->pma[0]);
+		meso_tn2[2] = pma[1][0] * pavgm[1] / (1.0 - flags.sw[20] * terms->pma[1]);
+		meso_tn2[3] = pma[2][0] * pavgm[2] / (1.0 - flags.sw[20] * flags.sw[22] * terms->pma[2]);
+		meso_tgn2[1] = pavgm[8] * pma[9][0] * (1.0 + flags.sw[20] * flags.sw[22] * terms->pma[9]) * meso_tn2[3] *
+					   meso_tn2[3] / (lane::ipow<2>(pma[2][0] * pavgm[2]));
 		meso_tn3[0] = meso_tn2[3];
 
 		/**
@@ -800,27 +1632,27 @@ namespace internal {
 		 * Temperature at nodes and gradients at end nodes
 		 * Inverse temperature a linear function of spherical harmonics
 		 **/
-		if (input.alt < zn3[0]) {
+		if (input.alt <= zn3[0]) {
 			meso_tgn3[0] = meso_tgn2[1];
-			meso_tn3[1] = pma[3][0] * pavgm[3] / (1.0 - flags.sw[22] * glob7s(pma[3], input, flags));
-			meso_tn3[2] = pma[4][0] * pavgm[4] / (1.0 - flags.sw[22] * glob7s(pma[4], input, flags));
-			meso_tn3[3] = pma[5][0] * pavgm[5] / (1.0 - flags.sw[22] * glob7s(pma[5], input, flags));
-			meso_tn3[4] = pma[6][0] * pavgm[6] / (1.0 - flags.sw[22] * glob7s(pma[6], input, flags));
-			meso_tgn3[1] = pma[7][0] * pavgm[7] * (1.0 + flags.sw[22] * glob7s(pma[7], input, flags)) * meso_tn3[4] * meso_tn3[4] /
+			meso_tn3[1] = pma[3][0] * pavgm[3] / (1.0 - flags.sw[22] * terms->pma[3]);
+			meso_tn3[2] = pma[4][0] * pavgm[4] / (1.0 - flags.sw[22] * terms->pma[4]);
+			meso_tn3[3] = pma[5][0] * pavgm[5] / (1.0 - flags.sw[22] * terms->pma[5]);
+			meso_tn3[4] = pma[6][0] * pavgm[6] / (1.0 - flags.sw[22] * terms->pma[6]);
+			meso_tgn3[1] = pma[7][0] * pavgm[7] * (1.0 + flags.sw[22] * terms->pma[7]) * meso_tn3[4] * meso_tn3[4] /
 						   (pow((pma[6][0] * pavgm[6]), 2.0));
 		}
 
 		/* Linear transition to full mixing below zn2[0] */
-		double dm28m = (flags.sw[0]) ? dm28 * 1.0E6 : dm28; // metric adjustment
-		double dmc = (input.alt > zmix) ? 1.0 - (zn2[0] - input.alt) / (zn2[0] - zmix) : 0.0;
-		double dz28 = soutput.d[2];
-		double dmr = 0;
-		double tz = 0;
+		const S dm28m = (flags.sw[0]) ? ws.dm28 * 1.0E6 : ws.dm28; // metric adjustment
+		const S dmc = (input.alt > zmix) ? 1.0 - (zn2[0] - input.alt) / (zn2[0] - zmix) : 0.0;
+		const S dz28 = soutput.d[2];
+		S dmr = 0;
+		S tz = 0;
 
 		/* N2 density */
 		dmr = soutput.d[2] / dm28m - 1.0;
 		output.d[2] =
-		  densm(input.alt, dm28m, pdm[2][4], tz, std::size(zn3), zn3, meso_tn3, meso_tgn3, std::size(zn2), zn2, meso_tn2, meso_tgn2);
+		  densm(input.alt, dm28m, pdm[2][4], tz, std::size(zn3), zn3, meso_tn3, meso_tgn3, std::size(zn2), zn2, meso_tn2, meso_tgn2, ws);
 		output.d[2] = output.d[2] * (1.0 + dmr * dmc);
 
 		/* He density */
@@ -851,11 +1683,13 @@ namespace internal {
 		if (flags.sw[0]) output.d[5] = output.d[5] / 1000;
 
 		/* temperature at altitude */
-		dd = densm(input.alt, 1.0, 0, tz, std::size(zn3), zn3, meso_tn3, meso_tgn3, std::size(zn2), zn2, meso_tn2, meso_tgn2);
+		densm(input.alt, 1.0, 0, tz, std::size(zn3), zn3, meso_tn3, meso_tgn3, std::size(zn2), zn2, meso_tn2, meso_tgn2, ws);
 		output.t[1] = tz;
 	}
 
-	void Nrlmsise::ghp7(NrlmsiseInput &input, NrlmsiseConfig &flags, NrlmsiseOutput &output, double press) {
+	template <class Flags>
+	void Nrlmsise::ghp7(NrlmsiseInput &input, const Flags &flags, NrlmsiseOutput &output, double press,
+							NrlmsiseWorkspace &ws) const {
 		constexpr double bm = 1.3806E-19;
 		constexpr double rgas = 831.4;
 		constexpr double test = 0.00043;
@@ -910,7 +1744,7 @@ namespace internal {
 			l++;
 			input.alt = z;
 
-			gtd7(input, flags, output);
+			gtd7(input, flags, output, ws);
 
 			z = input.alt;
 			xn = output.d[0] + output.d[1] + output.d[2] + output.d[3] + output.d[4] + output.d[6] + output.d[7];
@@ -924,14 +1758,14 @@ namespace internal {
 			if (std::sqrt(diff * diff) < test) return;
 
 			if (l == ltest) {
-				throw AtmosModelException("Iteration results do not converge.", AtmosModelException::MathmaticalError);
+				fail(ws, EvaluationStatus::NotConverged, "Iteration results do not converge.");
 				return;
 			}
 
 			xm = output.d[5] / xn / 1.66E-24;
 			if (flags.sw[0]) xm = xm * 1.0E3;
 
-			g = gsurf / (std::pow((1.0 + z / re), 2.0));
+			g = ws.gsurf / (std::pow((1.0 + z / ws.re), 2.0));
 			sh = rgas * output.t[1] / (xm * g);
 
 			/* new altitude estimate using scale height */
@@ -943,170 +1777,325 @@ namespace internal {
 		} while (1 == 1);
 	}
 
-	void Nrlmsise::gts7(NrlmsiseInput &input, NrlmsiseConfig &flags, NrlmsiseOutput &output) {
+	template <class S>
+	int Nrlmsise::columnRegime(const S &alt) {
+		constexpr double zn1_bottom = 72.5;
+		return (alt > pdl[1][15] ? 1 : 0) | (alt > zn1_bottom ? 2 : 0) | (alt < ptl_altitude_limit ? 4 : 0);
+	}
+
+	template <class S, class Flags>
+	void Nrlmsise::gts7(const NrlmsiseInputT<S> &input, const Flags &flags, const NrlmsiseGlobeTermsT<S> &terms,
+						NrlmsiseOutputT<S> &output, NrlmsiseWorkspaceT<S> &ws, NrlmsiseColumnCacheT<S> *cache) const {
+		if (!cache) {
+			NrlmsiseColumnT<S> column;
+			gts7Column(input, flags, terms, column, ws);
+			gts7Level(input, flags, column, output, ws);
+			return;
+		}
+
+		const int regime = columnRegime(input.alt);
+		if (!cache->has_column[regime]) {
+			gts7Column(input, flags, terms, cache->columns[regime], ws);
+			cache->has_column[regime] = true;
+		}
+		gts7Level(input, flags, cache->columns[regime], output, ws);
+	}
+
+	template <class S, class Flags>
+	void Nrlmsise::gts7Column(const NrlmsiseInputT<S> &input, const Flags &flags, const NrlmsiseGlobeTermsT<S> &terms,
+							  NrlmsiseColumnT<S> &column, NrlmsiseWorkspaceT<S> &ws) const {
+		S *meso_tn1 = column.meso_tn1, *meso_tgn1 = column.meso_tgn1;
+		S &tinf = column.tinf, &tlb = column.tlb, &s = column.s;
+		double &xmm = column.xmm;
 		double za;
-		double ddum, z;
 		double zn1[5] = {120.0, 110.0, 100.0, 90.0, 72.5};
-		double tinf;
-		double g0;
-		double tlb;
-		double s;
-		double db01, db04, db14, db16, db28, db32, db40;
-		double zh28, zh04, zh16, zh32, zh40, zh01, zh14;
-		double zhm28, zhm04, zhm16, zhm32, zhm40, zhm01, zhm14;
+		S g0;
+		S zh28, zh04, zh16, zh32, zh40, zh01, zh14;
 		double xmd;
-		double b28, b04, b16, b32, b40, b01, b14;
-		double tz;
-		double g28, g4, g16, g32, g40, g1, g14;
-		double zhf, xmm;
-		double zc04, zc16, zc32, zc40, zc01, zc14;
-		double hc04, hc16, hc32, hc40, hc01, hc14;
-		double hcc16, hcc32, hcc01, hcc14;
-		double zcc16, zcc32, zcc01, zcc14;
-		double rc16, rc32, rc01, rc14;
-		double rl;
-		double g16h, db16h, tho, zsht, zmho, zsho;
+		S tz;
+		S g28, g4, g16, g32, g40, g1, g14;
+		S zhf;
+		S g16h;
+		double zmho;
 		double alpha[9] = {-0.38, 0.0, 0.0, 0.0, 0.17, 0.0, -0.38, 0.0, 0.0};
-		double altl[8] = {200.0, 300.0, 160.0, 250.0, 240.0, 450.0, 320.0, 450.0};
-		double dd;
-		double hc216, hcc232;
 
 		za = pdl[1][15];
 		zn1[0] = za;
-		std::fill_n(output.d, std::size(output.d), 0);
 
 		/* TINF variations not important belloe ZA or ZN[0] */
 		if (input.alt > zn1[0])
-			tinf = ptm[0] * pt[0] * (1.0 + flags.sw[16] * globe7(pt, input, flags));
+			tinf = ptm[0] * pt[0] * (1.0 + flags.sw[16] * terms.pt);
 		else
 			tinf = ptm[0] * pt[0];
-		output.t[0] = tinf;
 
 		/* Gradient variations hot important bellow zn1[4] */
 		if (input.alt > zn1[4])
-			g0 = ptm[3] * ps[0] * (1.0 + flags.sw[19] * globe7(ps, input, flags));
+			g0 = ptm[3] * ps[0] * (1.0 + flags.sw[19] * terms.ps);
 		else
 			g0 = ptm[3] * ps[0];
-		tlb = ptm[1] * (1.0 + flags.sw[17] * globe7(pd[3], input, flags)) * pd[3][0];
+		tlb = ptm[1] * (1.0 + flags.sw[17] * terms.pd[3]) * pd[3][0];
 		s = g0 / (tinf - tlb);
 
 		/* Lower thermosphere temp variations not significant for density above 300 km */
-		if (input.alt < 300.0) {
-			meso_tn1[1] = ptm[6] * ptl[0][0] / (1.0 - flags.sw[18] * glob7s(ptl[0], input, flags));
-			meso_tn1[2] = ptm[2] * ptl[1][0] / (1.0 - flags.sw[18] * glob7s(ptl[1], input, flags));
-			meso_tn1[3] = ptm[7] * ptl[2][0] / (1.0 - flags.sw[18] * glob7s(ptl[2], input, flags));
-			meso_tn1[4] = ptm[4] * ptl[3][0] / (1.0 - flags.sw[18] * flags.sw[20] * glob7s(ptl[3], input, flags));
-			meso_tgn1[1] = ptm[8] * pma[8][0] * (1.0 + flags.sw[18] * flags.sw[20] * glob7s(pma[8], input, flags)) * meso_tn1[4] *
-						   meso_tn1[4] / (std::pow((ptm[4] * ptl[3][0]), 2.0));
+		if (input.alt < ptl_altitude_limit) {
+			meso_tn1[1] = ptm[6] * ptl[0][0] / (1.0 - flags.sw[18] * terms.ptl[0]);
+			meso_tn1[2] = ptm[2] * ptl[1][0] / (1.0 - flags.sw[18] * terms.ptl[1]);
+			meso_tn1[3] = ptm[7] * ptl[2][0] / (1.0 - flags.sw[18] * terms.ptl[2]);
+			meso_tn1[4] = ptm[4] * ptl[3][0] / (1.0 - flags.sw[18] * flags.sw[20] * terms.ptl[3]);
+			meso_tgn1[1] = ptm[8] * pma[8][0] * (1.0 + flags.sw[18] * flags.sw[20] * terms.pma[8]) * meso_tn1[4] *
+						   meso_tn1[4] / (lane::ipow<2>(ptm[4] * ptl[3][0]));
 		} else {
 			meso_tn1[1] = ptm[6] * ptl[0][0];
 			meso_tn1[2] = ptm[2] * ptl[1][0];
 			meso_tn1[3] = ptm[7] * ptl[2][0];
 			meso_tn1[4] = ptm[4] * ptl[3][0];
-			meso_tgn1[1] = ptm[8] * pma[8][0] * meso_tn1[4] * meso_tn1[4] / (std::pow((ptm[4] * ptl[3][0]), 2.0));
+			meso_tgn1[1] = ptm[8] * pma[8][0] * meso_tn1[4] * meso_tn1[4] / (lane::ipow<2>(ptm[4] * ptl[3][0]));
 		}
 
 		/* N2 variation factor at Zlb */
-		g28 = flags.sw[21] * globe7(pd[2], input, flags);
+		g28 = flags.sw[21] * terms.pd[2];
 
 		/* Varioation of turbopause height */
-		zhf = pdl[1][24] * (1.0 + flags.sw[5] * pdl[0][24] * Degree(input.g_lat).sin() * DoyAngle(input.doy - pt[13]).cos());
-		output.t[0] = tinf;
+		const S sin_lat = lane::sin(input.g_lat * constant::pi / 180.0);
+		zhf = pdl[1][24] * (1.0 + flags.sw[5] * pdl[0][24] * sin_lat * DoyAngle(input.doy - pt[13]).cos());
 		xmm = pdm[2][4];
-		z = input.alt;
 
-		/* Molecular nitrogen (N2) density*/
+		/* Molecular nitrogen (N2) density */
 		{
-
 			/* Diffusive density at Zlb */
-			db28 = pdm[2][0] * std::exp(g28) * pd[2][0];
-
-			/* Diffusive density at Alt */
-			output.d[2] = densu(z, db28, tinf, tlb, 28.0, alpha[2], output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
-			dd = output.d[2];
+			column.db28 = pdm[2][0] * lane::exp(g28) * pd[2][0];
 
 			/* Turbopause */
 			zh28 = pdm[2][2] * zhf;
-			zhm28 = pdm[2][3] * pdl[1][5];
+			column.zhm28 = pdm[2][3] * pdl[1][5];
 			xmd = 28.0 - xmm;
 
 			/* Mixed density at Zlb */
-			b28 = densu(zh28, db28, tinf, tlb, xmd, (alpha[2] - 1.0), tz, ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
-			if ((flags.sw[15]) && (z <= altl[2])) {
-				/* Mixed density at Alt */
-				dm28 = densu(z, b28, tinf, tlb, xmm, alpha[2], tz, ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
-				/* Net density at Alt */
-				output.d[2] = dnet(output.d[2], dm28, zhm28, xmm, 28.0);
-			}
+			column.b28 =
+			  densu(zh28, column.db28, tinf, tlb, xmd, (alpha[2] - 1.0), tz, ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
 		}
 
 		/* Atomic helium density */
 		{
 			/*   Density variation factor at Zlb */
-			g4 = flags.sw[21] * globe7(pd[0], input, flags);
+			g4 = flags.sw[21] * terms.pd[0];
 
 			/*  Diffusive density at Zlb */
-			db04 = pdm[0][0] * std::exp(g4) * pd[0][0];
-
-			/*  Diffusive density at Alt */
-			output.d[0] = densu(z, db04, tinf, tlb, 4., alpha[0], output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
-			dd = output.d[0];
-			if ((flags.sw[15]) && (z < altl[0])) {
+			column.db04 = pdm[0][0] * lane::exp(g4) * pd[0][0];
+			if (flags.sw[15]) {
 				/*  Turbopause */
 				zh04 = pdm[0][2];
 
 				/*  Mixed density at Zlb */
-				b04 =
-				  densu(zh04, db04, tinf, tlb, 4. - xmm, alpha[0] - 1., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
+				column.b04 =
+				  densu(zh04, column.db04, tinf, tlb, 4. - xmm, alpha[0] - 1., tz, ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
+
+				/*  Correction to specified mixing ratio at ground */
+				column.rl04 = lane::log(column.b28 * pdm[0][1] / column.b04);
+			}
+		}
+
+		/* Atomic oxygen (O) density */
+		{
+			/* Density variation factor at Zlb */
+			g16 = flags.sw[21] * terms.pd[1];
+
+			/* Diffusive density at Zlb */
+			column.db16 = pdm[1][0] * lane::exp(g16) * pd[1][0];
+			if (flags.sw[15]) {
+				/* Turbopause */
+				zh16 = pdm[1][2];
+
+				/* Mixed density at Zlb */
+				column.b16 = densu(zh16, column.db16, tinf, tlb, 16.0 - xmm, (alpha[1] - 1.0), tz, ptm[5], s, std::size(zn1), zn1, meso_tn1,
+								   meso_tgn1, ws);
+				column.rl16 = pdm[1][1] * pdl[1][16] * (1.0 + flags.sw[1] * pdl[0][23] * (input.f107A - 150.0));
+			}
+		}
+
+		/* Molecular oxygen (O2) density */
+		{
+			/* Density variation factor at Zlb */
+			g32 = flags.sw[21] * terms.pd[4];
+
+			/* Diffusive density at Zlb */
+			column.db32 = pdm[3][0] * lane::exp(g32) * pd[4][0];
+			if (flags.sw[15]) {
+				/* Turbopause */
+				zh32 = pdm[3][2];
+
+				/* Mixed density at Zlb */
+				column.b32 = densu(zh32, column.db32, tinf, tlb, 32. - xmm, alpha[3] - 1., tz, ptm[5], s, std::size(zn1), zn1, meso_tn1,
+								   meso_tgn1, ws);
+
+				/* Correction to specified mixing ratio at ground */
+				column.rl32 = lane::log(column.b28 * pdm[3][1] / column.b32);
+
+				/* Correction for general departure from diffusive equilibrium above Zlb */
+				column.rc32 = pdm[3][3] * pdl[1][23] * (1. + flags.sw[1] * pdl[0][23] * (input.f107A - 150.));
+			}
+		}
 
+		/* Atomic argon (Ar) density */
+		{
+			/* Density variation factor at Zlb */
+			g40 = flags.sw[21] * terms.pd[5];
+
+			/* Diffusive density at Zlb */
+			column.db40 = pdm[4][0] * lane::exp(g40) * pd[5][0];
+			if (flags.sw[15]) {
+				/* Turbopause */
+				zh40 = pdm[4][2];
+
+				/* Mixed density at Zlb */
+				column.b40 = densu(zh40, column.db40, tinf, tlb, 40. - xmm, alpha[4] - 1., tz, ptm[5], s, std::size(zn1), zn1, meso_tn1,
+								   meso_tgn1, ws);
+
+				/* Correction to specified mixing ratio at ground */
+				column.rl40 = lane::log(column.b28 * pdm[4][1] / column.b40);
+			}
+		}
+
+		/* Atomic hydrogen (H) density */
+		{
+			/* Density variation factor at Zlb */
+			g1 = flags.sw[21] * terms.pd[6];
+
+			/* Diffusive density at Zlb */
+			column.db01 = pdm[5][0] * lane::exp(g1) * pd[6][0];
+			if (flags.sw[15]) {
+				/* Turbopause */
+				zh01 = pdm[5][2];
+
+				/* Mixed density at Zlb */
+				column.b01 =
+				  densu(zh01, column.db01, tinf, tlb, 1. - xmm, alpha[6] - 1., tz, ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
+
+				/* Correction to specified mixing ratio at ground */
+				column.rl01 = lane::log(column.b28 * pdm[5][1] * std::fabs(pdl[1][17]) / column.b01);
+			}
+		}
+
+		/* Atomic nitorogen (N) density */
+		{
+			/* Density variation factor at Zlb */
+			g14 = flags.sw[21] * terms.pd[7];
+
+			/* Diffusive density at Zlb */
+			column.db14 = pdm[6][0] * lane::exp(g14) * pd[7][0];
+			if (flags.sw[15]) {
+				/* Turbopause */
+				zh14 = pdm[6][2];
+
+				/* Mixed density at Zlb */
+				column.b14 = densu(zh14, column.db14, tinf, tlb, 14. - xmm, alpha[7] - 1., tz, ptm[5], s, std::size(zn1), zn1, meso_tn1,
+								   meso_tgn1, ws);
+
+				/* Correction to specified mixing ratio at ground */
+				column.rl14 = lane::log(column.b28 * pdm[6][1] * std::fabs(pdl[0][2]) / column.b14);
+			}
+		}
+
+		/* Anomalous oxygen (Hot O, O2-) density */
+		{
+			g16h = flags.sw[21] * terms.pd[8];
+			column.db16h = pdm[7][0] * lane::exp(g16h) * pd[8][0];
+			column.tho = pdm[7][9] * pdl[0][6];
+			zmho = pdm[7][4];
+			column.zsho = scalh(zmho, 16.0, column.tho, ws);
+		}
+	}
+
+	template <class S, class Flags>
+	void Nrlmsise::gts7Level(const NrlmsiseInputT<S> &input, const Flags &flags, const NrlmsiseColumnT<S> &column,
+							 NrlmsiseOutputT<S> &output, NrlmsiseWorkspaceT<S> &ws) const {
+		S *meso_tn1 = ws.meso_tn1, *meso_tgn1 = ws.meso_tgn1;
+		const S &tinf = column.tinf, &tlb = column.tlb, &s = column.s;
+		const double &xmm = column.xmm;
+		const S &b28 = column.b28;
+		const double &zhm28 = column.zhm28;
+		double za;
+		S ddum, z;
+		double zn1[5] = {120.0, 110.0, 100.0, 90.0, 72.5};
+		double zhm04, zhm16, zhm32, zhm40, zhm01, zhm14;
+		S tz;
+		double zc04, zc16, zc32, zc40, zc01, zc14;
+		double hc04, hc16, hc32, hc40, hc01, hc14;
+		double hcc16, hcc32, hcc01, hcc14;
+		double zcc16, zcc32, zcc01, zcc14;
+		double rc16, rc01, rc14;
+		double zsht, zmho;
+		double alpha[9] = {-0.38, 0.0, 0.0, 0.0, 0.17, 0.0, -0.38, 0.0, 0.0};
+		double altl[8] = {200.0, 300.0, 160.0, 250.0, 240.0, 450.0, 320.0, 450.0};
+		S dd;
+		S dm04, dm16, dm32, dm40, dm01, dm14;
+		double hc216, hcc232;
+
+		za = pdl[1][15];
+		zn1[0] = za;
+		std::fill_n(output.d, std::size(output.d), 0);
+		std::copy(std::begin(column.meso_tn1), std::end(column.meso_tn1), meso_tn1);
+		std::copy(std::begin(column.meso_tgn1), std::end(column.meso_tgn1), meso_tgn1);
+
+		output.t[0] = tinf;
+		z = input.alt;
+
+		/* Molecular nitrogen (N2) density*/
+		{
+			/* Diffusive density at Alt */
+			output.d[2] =
+			  densu(z, column.db28, tinf, tlb, 28.0, alpha[2], output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
+			dd = output.d[2];
+
+			if ((flags.sw[15]) && (z <= altl[2])) {
+				/* Mixed density at Alt */
+				ws.dm28 = densu(z, b28, tinf, tlb, xmm, alpha[2], tz, ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
+				/* Net density at Alt */
+				output.d[2] = dnet(output.d[2], ws.dm28, zhm28, xmm, 28.0, ws);
+			}
+		}
+
+		/* Atomic helium density */
+		{
+			/*  Diffusive density at Alt */
+			output.d[0] =
+			  densu(z, column.db04, tinf, tlb, 4., alpha[0], output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
+			dd = output.d[0];
+			if ((flags.sw[15]) && (z < altl[0])) {
 				/*  Mixed density at Alt */
-				dm04 = densu(z, b04, tinf, tlb, xmm, 0., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
+				dm04 = densu(z, column.b04, tinf, tlb, xmm, 0., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
 				zhm04 = zhm28;
 
 				/*  Net density at Alt */
-				output.d[0] = dnet(output.d[0], dm04, zhm04, xmm, 4.);
+				output.d[0] = dnet(output.d[0], dm04, zhm04, xmm, 4., ws);
 
 				/*  Correction to specified mixing ratio at ground */
-				rl = std::log(b28 * pdm[0][1] / b04);
 				zc04 = pdm[0][4] * pdl[1][0];
 				hc04 = pdm[0][5] * pdl[1][1];
 
 				/*  Net density corrected at Alt */
-				output.d[0] = output.d[0] * ccor(z, rl, hc04, zc04);
+				output.d[0] = output.d[0] * ccor(z, column.rl04, hc04, zc04);
 			}
 		}
 
 		/* Atomic oxygen (O) density */
 		{
-			/* Density variation factor at Zlb */
-			g16 = flags.sw[21] * globe7(pd[1], input, flags);
-
-			/* Diffusive density at Zlb */
-			db16 = pdm[1][0] * std::exp(g16) * pd[1][0];
-
 			/* Diffusive density at Alt */
-			output.d[1] = densu(z, db16, tinf, tlb, 16., alpha[1], output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
+			output.d[1] =
+			  densu(z, column.db16, tinf, tlb, 16., alpha[1], output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
 			dd = output.d[1];
 
 			if ((flags.sw[15]) && (z <= altl[1])) {
-				/* Turbopause */
-				zh16 = pdm[1][2];
-
-				/* Mixed density at Zlb */
-				b16 = densu(zh16, db16, tinf, tlb, 16.0 - xmm, (alpha[1] - 1.0), output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1,
-							meso_tgn1);
-
 				/* Mixed density at Alt */
-				dm16 = densu(z, b16, tinf, tlb, xmm, 0., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
+				dm16 = densu(z, column.b16, tinf, tlb, xmm, 0., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
 				zhm16 = zhm28;
 
 				/* Net density at Alt */
-				output.d[1] = dnet(output.d[1], dm16, zhm16, xmm, 16.);
-				rl = pdm[1][1] * pdl[1][16] * (1.0 + flags.sw[1] * pdl[0][23] * (input.f107A - 150.0));
+				output.d[1] = dnet(output.d[1], dm16, zhm16, xmm, 16., ws);
 				hc16 = pdm[1][5] * pdl[1][3];
 				zc16 = pdm[1][4] * pdl[1][2];
 				hc216 = pdm[1][5] * pdl[1][4];
-				output.d[1] = output.d[1] * ccor2(z, rl, hc16, zc16, hc216);
+				output.d[1] = output.d[1] * ccor2(z, column.rl16, hc16, zc16, hc216);
 
 				/* Chemistry correction */
 				hcc16 = pdm[1][7] * pdl[1][13];
@@ -1120,117 +2109,77 @@ namespace internal {
 
 		/* Molecular oxygen (O2) density */
 		{
-			/* Density variation factor at Zlb */
-			g32 = flags.sw[21] * globe7(pd[4], input, flags);
-
-			/* Diffusive density at Zlb */
-			db32 = pdm[3][0] * std::exp(g32) * pd[4][0];
-
 			/* Diffusive density at Alt */
-			output.d[3] = densu(z, db32, tinf, tlb, 32., alpha[3], output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
+			output.d[3] =
+			  densu(z, column.db32, tinf, tlb, 32., alpha[3], output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
 			dd = output.d[3];
 
 			if (flags.sw[15]) {
 				if (z <= altl[3]) {
-					/* Turbopause */
-					zh32 = pdm[3][2];
-
-					/* Mixed density at Zlb */
-					b32 = densu(zh32, db32, tinf, tlb, 32. - xmm, alpha[3] - 1., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1,
-								meso_tgn1);
-
 					/* Mixed density at Alt */
-					dm32 = densu(z, b32, tinf, tlb, xmm, 0., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
+					dm32 = densu(z, column.b32, tinf, tlb, xmm, 0., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
 					zhm32 = zhm28;
 
 					/* Net density at Alt */
-					output.d[3] = dnet(output.d[3], dm32, zhm32, xmm, 32.);
+					output.d[3] = dnet(output.d[3], dm32, zhm32, xmm, 32., ws);
 
 					/* Correction to specified mixing ratio at ground */
-					rl = std::log(b28 * pdm[3][1] / b32);
 					hc32 = pdm[3][5] * pdl[1][7];
 					zc32 = pdm[3][4] * pdl[1][6];
-					output.d[3] = output.d[3] * ccor(z, rl, hc32, zc32);
+					output.d[3] = output.d[3] * ccor(z, column.rl32, hc32, zc32);
 				}
 
 				/* Correction for general departure from diffusive equilibrium above Zlb */
 				hcc32 = pdm[3][7] * pdl[1][22];
 				hcc232 = pdm[3][7] * pdl[0][22];
 				zcc32 = pdm[3][6] * pdl[1][21];
-				rc32 = pdm[3][3] * pdl[1][23] * (1. + flags.sw[1] * pdl[0][23] * (input.f107A - 150.));
 
 				/* Net density corrected at Alt */
-				output.d[3] = output.d[3] * ccor2(z, rc32, hcc32, zcc32, hcc232);
+				output.d[3] = output.d[3] * ccor2(z, column.rc32, hcc32, zcc32, hcc232);
 			}
 		}
 
 		/* Atomic argon (Ar) density */
 		{
-			/* Density variation factor at Zlb */
-			g40 = flags.sw[21] * globe7(pd[5], input, flags);
-
-			/* Diffusive density at Zlb */
-			db40 = pdm[4][0] * exp(g40) * pd[5][0];
-
 			/* Diffusive density at Alt */
-			output.d[4] = densu(z, db40, tinf, tlb, 40., alpha[4], output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
+			output.d[4] =
+			  densu(z, column.db40, tinf, tlb, 40., alpha[4], output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
 			dd = output.d[4];
 			if ((flags.sw[15]) && (z <= altl[4])) {
-				/* Turbopause */
-				zh40 = pdm[4][2];
-
-				/* Mixed density at Zlb */
-				b40 =
-				  densu(zh40, db40, tinf, tlb, 40. - xmm, alpha[4] - 1., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
-
 				/* Mixed density at Alt */
-				dm40 = densu(z, b40, tinf, tlb, xmm, 0., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
+				dm40 = densu(z, column.b40, tinf, tlb, xmm, 0., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
 				zhm40 = zhm28;
 
 				/* Net density at Alt */
-				output.d[4] = dnet(output.d[4], dm40, zhm40, xmm, 40.);
+				output.d[4] = dnet(output.d[4], dm40, zhm40, xmm, 40., ws);
 
 				/* Correction to specified mixing ratio at ground */
-				rl = std::log(b28 * pdm[4][1] / b40);
 				hc40 = pdm[4][5] * pdl[1][9];
 				zc40 = pdm[4][4] * pdl[1][8];
 
 				/* Net density corrected at Alt */
-				output.d[4] = output.d[4] * ccor(z, rl, hc40, zc40);
+				output.d[4] = output.d[4] * ccor(z, column.rl40, hc40, zc40);
 			}
 		}
 
 		/* Atomic hydrogen (H) density */
 		{
-			/* Density variation factor at Zlb */
-			g1 = flags.sw[21] * globe7(pd[6], input, flags);
-
-			/* Diffusive density at Zlb */
-			db01 = pdm[5][0] * std::exp(g1) * pd[6][0];
-
 			/* Diffusive density at Alt */
-			output.d[6] = densu(z, db01, tinf, tlb, 1., alpha[6], output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
+			output.d[6] =
+			  densu(z, column.db01, tinf, tlb, 1., alpha[6], output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
 			dd = output.d[6];
 			if ((flags.sw[15]) && (z <= altl[6])) {
-				/* Turbopause */
-				zh01 = pdm[5][2];
-
-				/* Mixed density at Zlb */
-				b01 =
-				  densu(zh01, db01, tinf, tlb, 1. - xmm, alpha[6] - 1., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
-
 				/* Mixed density at Alt */
-				dm01 = densu(z, b01, tinf, tlb, xmm, 0., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
+				dm01 = densu(z, column.b01, tinf, tlb, xmm, 0., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
 				zhm01 = zhm28;
 
 				/* Net density at Alt */
-				output.d[6] = dnet(output.d[6], dm01, zhm01, xmm, 1.);
+				output.d[6] = dnet(output.d[6], dm01, zhm01, xmm, 1., ws);
 
 				/* Correction to specified mixing ratio at ground */
-				rl = std::log(b28 * pdm[5][1] * std::sqrt(pdl[1][17] * pdl[1][17]) / b01);
 				hc01 = pdm[5][5] * pdl[1][11];
 				zc01 = pdm[5][4] * pdl[1][10];
-				output.d[6] = output.d[6] * ccor(z, rl, hc01, zc01);
+				output.d[6] = output.d[6] * ccor(z, column.rl01, hc01, zc01);
 
 				/* Chemistry correction */
 				hcc01 = pdm[5][7] * pdl[1][19];
@@ -1244,37 +2193,23 @@ namespace internal {
 
 		/* Atomic nitorogen (N) density */
 		{
-
-			/* Density variation factor at Zlb */
-			g14 = flags.sw[21] * globe7(pd[7], input, flags);
-
-			/* Diffusive density at Zlb */
-			db14 = pdm[6][0] * std::exp(g14) * pd[7][0];
-
 			/* Diffusive density at Alt */
-			output.d[7] = densu(z, db14, tinf, tlb, 14., alpha[7], output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
+			output.d[7] =
+			  densu(z, column.db14, tinf, tlb, 14., alpha[7], output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
 			dd = output.d[7];
 
 			if ((flags.sw[15]) && (z <= altl[7])) {
-				/* Turbopause */
-				zh14 = pdm[6][2];
-
-				/* Mixed density at Zlb */
-				b14 =
-				  densu(zh14, db14, tinf, tlb, 14. - xmm, alpha[7] - 1., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
-
 				/* Mixed density at Alt */
-				dm14 = densu(z, b14, tinf, tlb, xmm, 0., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
+				dm14 = densu(z, column.b14, tinf, tlb, xmm, 0., output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
 				zhm14 = zhm28;
 
 				/* Net density at Alt */
-				output.d[7] = dnet(output.d[7], dm14, zhm14, xmm, 14.);
+				output.d[7] = dnet(output.d[7], dm14, zhm14, xmm, 14., ws);
 
 				/* Correction to specified mixing ratio at ground */
-				rl = std::log(b28 * pdm[6][1] * std::sqrt(pdl[0][2] * pdl[0][2]) / b14);
 				hc14 = pdm[6][5] * pdl[0][1];
 				zc14 = pdm[6][4] * pdl[0][0];
-				output.d[7] = output.d[7] * ccor(z, rl, hc14, zc14);
+				output.d[7] = output.d[7] * ccor(z, column.rl14, hc14, zc14);
 
 				/* Chemistry correction */
 				hcc14 = pdm[6][7] * pdl[0][4];
@@ -1288,22 +2223,19 @@ namespace internal {
 
 		/* Anomalous oxygen (Hot O, O2-) density */
 		{
-			g16h = flags.sw[21] * globe7(pd[8], input, flags);
-			db16h = pdm[7][0] * std::exp(g16h) * pd[8][0];
-			tho = pdm[7][9] * pdl[0][6];
-			dd = densu(z, db16h, tho, tho, 16., alpha[8], output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
+			dd = densu(z, column.db16h, column.tho, column.tho, 16., alpha[8], output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1,
+					   meso_tgn1, ws);
 			zsht = pdm[7][5];
 			zmho = pdm[7][4];
-			zsho = scalh(zmho, 16.0, tho);
-			output.d[8] = dd * std::exp(-zsht / zsho * (std::exp(-(z - zmho) / zsht) - 1.));
+			output.d[8] = dd * lane::exp(-zsht / column.zsho * (lane::exp(-(z - zmho) / zsht) - 1.));
 
 			/* total mass density */
 			output.d[5] = 1.66E-24 * (4.0 * output.d[0] + 16.0 * output.d[1] + 28.0 * output.d[2] + 32.0 * output.d[3] +
 									  40.0 * output.d[4] + output.d[6] + 14.0 * output.d[7]);
 
 			/* temperature */
-			z = std::sqrt(input.alt * input.alt);
-			ddum = densu(z, 1.0, tinf, tlb, 0.0, 0.0, output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1);
+			z = lane::sqrt(input.alt * input.alt);
+			ddum = densu(z, 1.0, tinf, tlb, 0.0, 0.0, output.t[1], ptm[5], s, std::size(zn1), zn1, meso_tn1, meso_tgn1, ws);
 
 			(void)ddum; // silence gcc
 
@@ -12,12 +12,34 @@
 
 #pragma once
 
+#include <algorithm>
 #include <charconv>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
-#include <map>
+#include <limits>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <vector>
+
+// バイナリ形式のデータベースを mmap で読み込む (0 の場合はファイル全体を読み込む)
+#ifndef GEOATMOS_SPACE_WEATHER_MMAP
+#if defined(__unix__) || defined(__APPLE__)
+#define GEOATMOS_SPACE_WEATHER_MMAP 1
+#else
+#define GEOATMOS_SPACE_WEATHER_MMAP 0
+#endif
+#endif
+
+#if GEOATMOS_SPACE_WEATHER_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include "Essential.hpp"
 #include "GeoAtmosType.hpp"
@@ -63,8 +85,97 @@ struct SpaceWeatherData {
 		f107_adj_last81(0) {}
 };
 
+/**
+ * @brief 3時間枠ごとに事前計算した NRLMSISE-00 の宇宙天気入力
+ * @note 参照できないデータを含む項目は対応するフラグが立たない
+ *
+ */
+struct SpaceWeatherSlot {
+	enum Flag : std::uint8_t { HasAp = 1 << 0, HasF107Average = 1 << 1, HasF107Daily = 1 << 2 };
+
+	double ap[7];		// NRLMSISE-00 の ap_a (日平均, 0h, -3h, -6h, -9h, -12h ~ -33h 平均, -36h ~ -57h 平均)
+	float f107_average; // 81日中心平均の F10.7 (1 AU 補正値)
+	float f107_daily;	// 前日の F10.7 (1 AU 補正値)
+	std::uint8_t flags;
+};
+
+namespace internal {
+	/**
+	 * @brief 宇宙天気データベースのバイナリ形式のヘッダ
+	 * @note ヘッダの後に SpaceWeatherBinaryRecord が先頭日から1日ずつ欠けなく並ぶ (欠測日は day = space_weather_missing_day).
+	 *       その後に先頭日から最終日の翌日までの3時間枠の SpaceWeatherSlot が続く.
+	 *       バイト順と構造体の配置は書き出した環境のものをそのまま使うため, byte_order, record_size, slot_size が一致しない場合は読み込まない
+	 *
+	 */
+	struct SpaceWeatherBinaryHeader {
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t byte_order;
+		std::uint32_t record_size;
+		std::uint32_t slot_size;
+		std::uint64_t count;
+	};
+
+	/**
+	 * @brief 宇宙天気データベースのバイナリ形式のレコード (1日分)
+	 *
+	 */
+	struct SpaceWeatherBinaryRecord {
+		std::int64_t day; // DateTime::ticks() / ticks_per_day
+		SpaceWeatherData data;
+	};
+	static_assert(std::is_trivially_copyable_v<SpaceWeatherBinaryRecord>, "SpaceWeatherBinaryRecord must be trivially copyable.");
+	static_assert(std::is_trivially_copyable_v<SpaceWeatherSlot>, "SpaceWeatherSlot must be trivially copyable.");
+	static_assert(sizeof(SpaceWeatherBinaryRecord) % alignof(SpaceWeatherSlot) == 0, "SpaceWeatherSlot table must stay aligned.");
+
+	constexpr std::size_t space_weather_slots_per_day = 8;
+
+	/**
+	 * @brief num_days 日分のデータに対する3時間枠の数
+	 * @note 前日の F10.7 は最終日の翌日まで参照できるため, 1日分多く持つ
+	 *
+	 */
+	constexpr std::size_t spaceWeatherSlotCount(std::size_t num_days) {
+		return (num_days > 0) ? (num_days + 1) * space_weather_slots_per_day : 0;
+	}
+
+	constexpr std::int64_t space_weather_missing_day = std::numeric_limits<std::int64_t>::min();
+
+	constexpr char space_weather_binary_magic[8] = {'G', 'A', 'S', 'W', 'B', 'I', 'N', '\0'};
+	constexpr std::uint32_t space_weather_binary_version = 2;
+	constexpr std::uint32_t space_weather_binary_byte_order = 0x01020304;
+
+	/**
+	 * @brief 読み込み専用のファイルマッピング
+	 * @note GEOATMOS_SPACE_WEATHER_MMAP が 0 の場合はファイル全体をメモリに読み込む
+	 *
+	 */
+	class MappedFile {
+	  public:
+		MappedFile(const std::filesystem::path& path);
+		~MappedFile();
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool isOpen() const { return m_data != nullptr; }
+		const char* data() const { return m_data; }
+		std::size_t size() const { return m_size; }
+
+	  private:
+		const char* m_data;
+		std::size_t m_size;
+#if !GEOATMOS_SPACE_WEATHER_MMAP
+		std::vector<char> m_buffer;
+#endif
+	};
+} // namespace internal
+
 /**
  * @brief 宇宙天気データベース
+ * @note CelesTrak の CSV 形式と, writeBinary() で書き出したバイナリ形式を読み込める.
+ *       バイナリ形式はファイルを mmap して直接参照するため, 読み込みはファイルサイズによらず一定時間で終わる.
+ *       データは先頭日からの日数で添字付けした連続配列に置くため, 参照は O(1) で行える.
+ *       NRLMSISE-00 の入力は読み込み時に3時間枠ごとに計算しておき, slot() で1回の参照で取り出せる
  *
  */
 class SpaceWeather {
@@ -73,43 +184,42 @@ class SpaceWeather {
 	SpaceWeather(const char* filename) : SpaceWeather(std::filesystem::path(filename)) {}
 	SpaceWeather(const std::string& filename) : SpaceWeather(std::filesystem::path(filename)) {}
 	SpaceWeather(std::ifstream& ifs);
-	~SpaceWeather() { m_data.clear(); }
 
-	const SpaceWeatherData& at(const DateTime& dt) const { return m_data.at(toKey(dt)); }
+	const SpaceWeatherData& at(const DateTime& dt) const { return record(dt); }
 
-	int dailyApIndex(const DateTime& dt) const { return m_data.at(toKey(dt)).ap_avg; }
+	int dailyApIndex(const DateTime& dt) const { return record(dt).ap_avg; }
 
-	int apIndex(const DateTime& dt) const { return m_data.at(toKey(dt)).ap[getIndex(dt)]; }
+	int apIndex(const DateTime& dt) const { return record(dt).ap[getIndex(dt)]; }
 
 	int apIndex(const DateTime& dt, TimeSpan span) const {
 		auto adj_dt = dt + span;
-		return m_data.at(toKey(adj_dt)).ap[getIndex(adj_dt)];
+		return record(adj_dt).ap[getIndex(adj_dt)];
 	}
 
-	int kpIndex(const DateTime& dt) const { return m_data.at(toKey(dt)).kp[getIndex(dt)]; }
+	int kpIndex(const DateTime& dt) const { return record(dt).kp[getIndex(dt)]; }
 
 	int kpIndex(const DateTime& dt, TimeSpan span) const {
 		auto adj_dt = dt + span;
-		return m_data.at(toKey(adj_dt)).kp[getIndex(adj_dt)];
+		return record(adj_dt).kp[getIndex(adj_dt)];
 	}
 
-	double cpIndex(const DateTime& dt) const { return (double)m_data.at(toKey(dt)).cp; }
+	double cpIndex(const DateTime& dt) const { return (double)record(dt).cp; }
 
-	double adjustedF107(const DateTime& dt) const { return (double)m_data.at(toKey(dt)).f107_adj; }
+	double adjustedF107(const DateTime& dt) const { return (double)record(dt).f107_adj; }
 
-	double observedF107(const DateTime& dt) const { return (double)m_data.at(toKey(dt)).f107_obs; }
+	double observedF107(const DateTime& dt) const { return (double)record(dt).f107_obs; }
 
-	double adjustedF107Center81(const DateTime& dt) const { return (double)m_data.at(toKey(dt)).f107_adj_center81; }
+	double adjustedF107Center81(const DateTime& dt) const { return (double)record(dt).f107_adj_center81; }
 
-	double observedF107Center81(const DateTime& dt) const { return (double)m_data.at(toKey(dt)).f107_obs_center81; }
+	double observedF107Center81(const DateTime& dt) const { return (double)record(dt).f107_obs_center81; }
 
-	double adjustedF107Last81(const DateTime& dt) const { return (double)m_data.at(toKey(dt)).f107_adj_last81; }
+	double adjustedF107Last81(const DateTime& dt) const { return (double)record(dt).f107_adj_last81; }
 
-	double observedF107Last81(const DateTime& dt) const { return (double)m_data.at(toKey(dt)).f107_obs_last81; }
+	double observedF107Last81(const DateTime& dt) const { return (double)record(dt).f107_obs_last81; }
 
 	bool find(const DateTime& dt) {
 		if (m_is_exist && m_is_loaded) {
-			if (m_data.count(toKey(dt)) > 0) {
+			if (findRecord(dt) != nullptr) {
 				return true;
 			} else {
 				return false;
@@ -119,17 +229,53 @@ class SpaceWeather {
 		}
 	}
 
+	/**
+	 * @brief 時刻を含む3時間枠の NRLMSISE-00 の宇宙天気入力
+	 *
+	 * @param dt 時刻
+	 * @return const SpaceWeatherSlot* データベースの範囲外の場合は nullptr
+	 */
+	const SpaceWeatherSlot* slot(const DateTime& dt) const {
+		const std::int64_t slot_ticks = 3 * constant::ticks_per_hour;
+		const std::uint64_t i = static_cast<std::uint64_t>(dt.ticks() / slot_ticks - m_first_day * internal::space_weather_slots_per_day);
+		return (i < internal::spaceWeatherSlotCount(m_num_records)) ? &m_slots[i] : nullptr;
+	}
+
+	/**
+	 * @brief 読み込んだデータをバイナリ形式で書き出す
+	 *
+	 * @param path 出力先
+	 * @return true 書き出しに成功
+	 */
+	bool writeBinary(const std::filesystem::path& path) const;
+
   private:
 	static constexpr char c_separator = ',';
-	std::map<DateTime, SpaceWeatherData> m_data;
+	std::shared_ptr<const std::vector<internal::SpaceWeatherBinaryRecord>> m_table;	// CSV 形式の場合のみ
+	std::shared_ptr<const std::vector<SpaceWeatherSlot>> m_slot_table;				// CSV 形式の場合のみ
+	std::shared_ptr<const internal::MappedFile> m_file;								// バイナリ形式の場合のみ
+	const internal::SpaceWeatherBinaryRecord* m_records = nullptr;					// m_table または m_file 上のレコード
+	const SpaceWeatherSlot* m_slots = nullptr;										// m_slot_table または m_file 上の3時間枠
+	std::size_t m_num_records = 0;
+	std::int64_t m_first_day = 0;													// m_records[0] の日 (ticks / ticks_per_day)
 	bool m_is_exist;
 	bool m_is_loaded;
 	DateTime m_min_dt;
 	DateTime m_max_dt;
 
-	DateTime toKey(const DateTime& dt) const { return DateTime((dt.ticks() / constant::ticks_per_day) * constant::ticks_per_day); }
+
+	const SpaceWeatherData* findRecord(const DateTime& dt) const;
+
+	const SpaceWeatherData& record(const DateTime& dt) const {
+		const SpaceWeatherData* data = findRecord(dt);
+		if (!data) throw std::out_of_range("Space weather data not found.");
+		return *data;
+	}
 
 	bool load(std::ifstream& ifs);
+	bool loadBinary(const std::filesystem::path& path);
+	SpaceWeatherSlot makeSlot(const DateTime& dt) const;
+	static bool isBinary(const std::filesystem::path& path);
 
 	bool exist(const std::filesystem::path& path) {
 		namespace fs = std::filesystem;
@@ -206,17 +352,22 @@ class SpaceWeather {
 	}
 };
 
-SpaceWeather::SpaceWeather(const std::filesystem::path& f_path)
+inline SpaceWeather::SpaceWeather(const std::filesystem::path& f_path)
   : m_is_exist(false), m_is_loaded(false), m_min_dt(DateTime::max()), m_max_dt(DateTime::min()) {
 	namespace fs = std::filesystem;
 
 	if (exist(f_path)) {
-		std::ifstream ifs(f_path);
-		m_is_loaded = load(ifs);
+		if (isBinary(f_path)) {
+			m_is_loaded = loadBinary(f_path);
+		} else {
+			std::ifstream ifs(f_path);
+			m_is_loaded = load(ifs);
+		}
 	}
 }
 
-SpaceWeather::SpaceWeather(std::ifstream& ifs) {
+inline SpaceWeather::SpaceWeather(std::ifstream& ifs)
+  : m_is_exist(false), m_is_loaded(false), m_min_dt(DateTime::max()), m_max_dt(DateTime::min()) {
 	if (ifs.is_open()) {
 		m_is_exist = true;
 		m_is_loaded = load(ifs);
@@ -226,18 +377,22 @@ SpaceWeather::SpaceWeather(std::ifstream& ifs) {
 	}
 }
 
-bool SpaceWeather::load(std::ifstream& ifs) {
+inline bool SpaceWeather::load(std::ifstream& ifs) {
 	if (ifs.is_open()) {
 		std::size_t s_pos = 0, e_pos = 0;
 		std::string line;
 		DateTime dt;
 		SpaceWeatherData data;
+		std::vector<internal::SpaceWeatherBinaryRecord> rows;
 		m_min_dt = DateTime::max();
 		m_max_dt = DateTime::min();
 
 		while (std::getline(ifs, line)) {
+			// 見出し行など日付で始まらない行は読み飛ばす
+			const auto parsed = DateTime::parse(std::string_view(line).substr(s_pos, 10));
+			if (!parsed) continue;
 			try {
-				dt = DateTime(line.substr(s_pos, 10));
+				dt = *parsed;
 				m_min_dt = std::min(m_min_dt, dt);
 				m_max_dt = std::max(m_max_dt, dt);
 				e_pos = 10;
@@ -261,15 +416,200 @@ bool SpaceWeather::load(std::ifstream& ifs) {
 				readBlock(line, e_pos + 1, e_pos, data.f107_obs_last81);
 				readBlock(line, e_pos + 1, e_pos, data.f107_adj_center81);
 				readBlock(line, e_pos + 1, e_pos, data.f107_adj_last81);
-				m_data.emplace(dt, data);
+				internal::SpaceWeatherBinaryRecord row;
+				std::memset(static_cast<void*>(&row), 0, sizeof(row)); // パディングも 0 にして出力を再現可能にする
+				row.day = dt.ticks() / constant::ticks_per_day;
+				row.data = data;
+				rows.push_back(row);
 			} catch (const std::exception& e) {
 				continue;
 			}
 		}
 
+		// 日付順の連続配列に並べ直す (同じ日が重複した場合は先に現れた行を使う)
+		using Record = internal::SpaceWeatherBinaryRecord;
+		std::stable_sort(rows.begin(), rows.end(), [](const Record& a, const Record& b) { return a.day < b.day; });
+
+		auto table = std::make_shared<std::vector<internal::SpaceWeatherBinaryRecord>>();
+		if (!rows.empty()) {
+			internal::SpaceWeatherBinaryRecord missing;
+			std::memset(static_cast<void*>(&missing), 0, sizeof(missing));
+			missing.day = internal::space_weather_missing_day;
+
+			table->assign(rows.back().day - rows.front().day + 1, missing);
+			for (auto it = rows.rbegin(); it != rows.rend(); ++it) (*table)[it->day - rows.front().day] = *it;
+			m_first_day = rows.front().day;
+		}
+		m_records = table->data();
+		m_num_records = table->size();
+		m_table = std::move(table);
+
+		const std::int64_t slot_ticks = 3 * constant::ticks_per_hour;
+		auto slots = std::make_shared<std::vector<SpaceWeatherSlot>>(internal::spaceWeatherSlotCount(m_num_records));
+		for (std::size_t i = 0; i < slots->size(); i++) {
+			(*slots)[i] = makeSlot(DateTime((m_first_day * (std::int64_t)internal::space_weather_slots_per_day + i) * slot_ticks));
+		}
+		m_slots = slots->data();
+		m_slot_table = std::move(slots);
+
 		return true;
 	}
 
 	return false;
 }
+
+inline const SpaceWeatherData* SpaceWeather::findRecord(const DateTime& dt) const {
+	const std::int64_t day = dt.ticks() / constant::ticks_per_day;
+	const std::uint64_t i = static_cast<std::uint64_t>(day - m_first_day); // 先頭日より前は大きな値になり範囲外となる
+	if (i >= m_num_records || m_records[i].day != day) return nullptr;
+	return &m_records[i].data;
+}
+
+inline bool SpaceWeather::isBinary(const std::filesystem::path& path) {
+	std::ifstream ifs(path, std::ios::binary);
+	char magic[sizeof(internal::space_weather_binary_magic)] = {};
+	ifs.read(magic, sizeof(magic));
+	return ifs && std::memcmp(magic, internal::space_weather_binary_magic, sizeof(magic)) == 0;
+}
+
+inline bool SpaceWeather::loadBinary(const std::filesystem::path& path) {
+	using internal::SpaceWeatherBinaryHeader;
+	using internal::SpaceWeatherBinaryRecord;
+
+	auto file = std::make_shared<const internal::MappedFile>(path);
+	if (!file->isOpen() || file->size() < sizeof(SpaceWeatherBinaryHeader)) return false;
+
+	SpaceWeatherBinaryHeader header;
+	std::memcpy(&header, file->data(), sizeof(header));
+	// count はファイル由来の値なので, サイズ計算が桁あふれしないよう先にファイルに収まる件数か確かめる
+	if (header.count > file->size() / sizeof(SpaceWeatherBinaryRecord)) return false;
+	const std::size_t slot_bytes = internal::spaceWeatherSlotCount(header.count) * sizeof(SpaceWeatherSlot);
+	if (header.version != internal::space_weather_binary_version || header.byte_order != internal::space_weather_binary_byte_order ||
+		header.record_size != sizeof(SpaceWeatherBinaryRecord) || header.slot_size != sizeof(SpaceWeatherSlot) ||
+		file->size() != sizeof(header) + header.count * sizeof(SpaceWeatherBinaryRecord) + slot_bytes) {
+		return false;
+	}
+
+	auto records = reinterpret_cast<const SpaceWeatherBinaryRecord*>(file->data() + sizeof(header));
+	if (header.count > 0) {
+		// 連続配列であることを両端で確認する
+		const std::int64_t first_day = records[0].day, last_day = records[header.count - 1].day;
+		if (first_day == internal::space_weather_missing_day || last_day - first_day + 1 != static_cast<std::int64_t>(header.count)) {
+			return false;
+		}
+		m_first_day = first_day;
+		m_min_dt = DateTime(first_day * constant::ticks_per_day);
+		m_max_dt = DateTime(last_day * constant::ticks_per_day);
+	}
+
+	m_file = file;
+	m_records = records;
+	m_slots = reinterpret_cast<const SpaceWeatherSlot*>(records + header.count);
+	m_num_records = header.count;
+	return true;
+}
+
+inline SpaceWeatherSlot SpaceWeather::makeSlot(const DateTime& dt) const {
+	constexpr double time_step = -3.0;	  // -3h
+	constexpr int avg_times = 8;		  // 8 times
+	constexpr int m12_m33_start = 12 / 3; // -12h
+	constexpr int m12_m33_end = 33 / 3;	  // -33h
+	constexpr int m36_m57_start = 36 / 3; // -36h
+	constexpr int m36_m57_end = 57 / 3;	  // -57h
+
+	SpaceWeatherSlot slot;
+	std::memset(static_cast<void*>(&slot), 0, sizeof(slot)); // パディングも 0 にして出力を再現可能にする
+
+	MagneticIndex ap{};
+	try {
+		// Daily AP
+		ap.ap[0] = dailyApIndex(dt);
+
+		// 3h AP from 0h, -3h, -6h, -9h
+		for (int i = 1; i < 5; i++) ap.ap[i] = apIndex(dt, Hours{time_step * (i - 1)});
+
+		// Average 3h AP from -12h ~ -33h
+		for (int i = m12_m33_start; i < m12_m33_end; i++) ap.ap[5] += (double)apIndex(dt, Hours{time_step * i});
+		ap.ap[5] /= (double)avg_times;
+
+		// Average 3h AP from -36h ~ -57h
+		for (int i = m36_m57_start; i < m36_m57_end; i++) ap.ap[6] += (double)apIndex(dt, Hours{time_step * i});
+		ap.ap[6] /= (double)avg_times;
+
+		slot.flags |= SpaceWeatherSlot::HasAp;
+	} catch (const std::out_of_range& e) {
+		ap = MagneticIndex{};
+	}
+	std::copy(std::begin(ap.ap), std::end(ap.ap), slot.ap);
+
+	if (const SpaceWeatherData* data = findRecord(dt)) {
+		slot.f107_average = data->f107_adj_center81;
+		slot.flags |= SpaceWeatherSlot::HasF107Average;
+	}
+	if (const SpaceWeatherData* data = findRecord(dt - Days(1))) {
+		slot.f107_daily = data->f107_adj;
+		slot.flags |= SpaceWeatherSlot::HasF107Daily;
+	}
+	return slot;
+}
+
+inline bool SpaceWeather::writeBinary(const std::filesystem::path& path) const {
+	using internal::SpaceWeatherBinaryHeader;
+	using internal::SpaceWeatherBinaryRecord;
+
+	SpaceWeatherBinaryHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, internal::space_weather_binary_magic, sizeof(header.magic));
+	header.version = internal::space_weather_binary_version;
+	header.byte_order = internal::space_weather_binary_byte_order;
+	header.record_size = sizeof(SpaceWeatherBinaryRecord);
+	header.slot_size = sizeof(SpaceWeatherSlot);
+	header.count = m_num_records;
+
+	std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+	ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	if (m_num_records > 0) {
+		ofs.write(reinterpret_cast<const char*>(m_records), m_num_records * sizeof(SpaceWeatherBinaryRecord));
+		ofs.write(reinterpret_cast<const char*>(m_slots), internal::spaceWeatherSlotCount(m_num_records) * sizeof(SpaceWeatherSlot));
+	}
+	return static_cast<bool>(ofs);
+}
+
+namespace internal {
+#if GEOATMOS_SPACE_WEATHER_MMAP
+	inline MappedFile::MappedFile(const std::filesystem::path& path) : m_data(nullptr), m_size(0) {
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) return;
+
+		struct stat st;
+		if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+			void* p = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+			if (p != MAP_FAILED) {
+				m_data = static_cast<const char*>(p);
+				m_size = st.st_size;
+			}
+		}
+		::close(fd);
+	}
+
+	inline MappedFile::~MappedFile() {
+		if (m_data) ::munmap(const_cast<char*>(m_data), m_size);
+	}
+#else
+	inline MappedFile::MappedFile(const std::filesystem::path& path) : m_data(nullptr), m_size(0) {
+		std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+		if (!ifs) return;
+
+		m_buffer.resize(static_cast<std::size_t>(ifs.tellg()));
+		ifs.seekg(0);
+		if (!m_buffer.empty() && ifs.read(m_buffer.data(), m_buffer.size())) {
+			m_data = m_buffer.data();
+			m_size = m_buffer.size();
+		}
+	}
+
+	inline MappedFile::~MappedFile() {}
+#endif
+} // namespace internal
+
 GEOATMOS_NAMESPACE_END
\ No newline at end of file